@@ -42,11 +42,15 @@ ExternalProject_Add(opengeode-io
         -DOPENGEODE_IO_WITH_PYTHON:BOOL=${OPENGEODE_IO_WITH_PYTHON}
         -DUSE_SUPERBUILD:BOOL=OFF
         -DASSIMP_INSTALL_PREFIX:PATH=${ASSIMP_INSTALL_PREFIX}
+        -DLZ4_INSTALL_PREFIX:PATH=${LZ4_INSTALL_PREFIX}
+        -DLZMA_INSTALL_PREFIX:PATH=${LZMA_INSTALL_PREFIX}
         -DPUGIXML_INSTALL_PREFIX:PATH=${PUGIXML_INSTALL_PREFIX}
         -DCMAKE_INSTALL_PREFIX:PATH=${OpenGeode-IO_PATH_INSTALL}
     BINARY_DIR ${OpenGeode-IO_PATH_BIN}
     DEPENDS 
         assimp
+        lz4
+        lzma
         pugixml
 )
 
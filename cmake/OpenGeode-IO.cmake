@@ -31,6 +31,8 @@ find_package(GDAL REQUIRED CONFIG)
 find_package(nlohmann_json REQUIRED CONFIG)
 find_package(zlib REQUIRED CONFIG)
 find_package(assimp REQUIRED CONFIG NO_DEFAULT_PATH PATHS ${ASSIMP_INSTALL_PREFIX})
+find_package(lz4 REQUIRED CONFIG NO_DEFAULT_PATH PATHS ${LZ4_INSTALL_PREFIX})
+find_package(liblzma REQUIRED CONFIG NO_DEFAULT_PATH PATHS ${LZMA_INSTALL_PREFIX})
 find_package(pugixml REQUIRED CONFIG NO_DEFAULT_PATH PATHS ${PUGIXML_INSTALL_PREFIX})
 
 # Install OpenGeode-IO third-parties
@@ -46,6 +48,8 @@ if(NOT BUILD_SHARED_LIBS)
     install(
         DIRECTORY
             ${ASSIMP_INSTALL_PREFIX}/
+            ${LZ4_INSTALL_PREFIX}/
+            ${LZMA_INSTALL_PREFIX}/
         DESTINATION
             .
         COMPONENT
@@ -35,6 +35,8 @@ endif()
 include(ExternalProject)
 
 include(${PROJECT_SOURCE_DIR}/cmake/ConfigureAssimp.cmake)
+include(${PROJECT_SOURCE_DIR}/cmake/ConfigureLZ4.cmake)
+include(${PROJECT_SOURCE_DIR}/cmake/ConfigureLZMA.cmake)
 include(${PROJECT_SOURCE_DIR}/cmake/ConfigurePugixml.cmake)
 include(${PROJECT_SOURCE_DIR}/cmake/ConfigureOpenGeode-IO.cmake)
 
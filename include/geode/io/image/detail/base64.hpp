@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <absl/types/span.h>
+
+#include <geode/io/image/common.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * Decode a base64 string straight into the given output bytes.
+         * Whitespace inside the string is skipped and decoding stops at the
+         * first padding character.
+         * @return the number of decoded bytes.
+         * @exception OpenGeodeException if the input is not valid base64 or
+         * if the output is too small.
+         */
+        size_t opengeode_io_image_api decode_base64(
+            std::string_view input, absl::Span< char > output );
+
+        [[nodiscard]] constexpr size_t base64_encoded_size( size_t nb_bytes )
+        {
+            return ( nb_bytes + 2 ) / 3 * 4;
+        }
+
+        /*!
+         * Append the padded base64 encoding of the given bytes to the output.
+         */
+        void opengeode_io_image_api encode_base64(
+            std::string_view bytes, std::string& output );
+    } // namespace detail
+} // namespace geode
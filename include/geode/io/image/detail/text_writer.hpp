@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <charconv>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <geode/basic/range.hpp>
+
+#include <geode/geometry/point.hpp>
+
+#include <geode/io/image/common.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * Append the decimal text of an integer to the output
+         */
+        template < typename T >
+        std::enable_if_t< std::is_integral_v< T > > append_number(
+            std::string& output, T value )
+        {
+            if constexpr( std::is_same_v< T, bool > )
+            {
+                output.push_back( value ? '1' : '0' );
+            }
+            else
+            {
+                // Enough for 64 bits integers and their sign
+                char buffer[24];
+                const auto result =
+                    std::to_chars( buffer, buffer + sizeof( buffer ), value );
+                output.append( buffer, result.ptr );
+            }
+        }
+
+        /*!
+         * Append the text of a floating point value to the output, with the
+         * given number of significant digits. If 0, the shortest text read
+         * back as the exact same value is written.
+         */
+        void opengeode_io_image_api append_number( std::string& output,
+            double value,
+            local_index_t significant_digits );
+
+        void opengeode_io_image_api append_number( std::string& output,
+            float value,
+            local_index_t significant_digits );
+
+        /*!
+         * Buffered text writer formatting numbers with std::to_chars.
+         * Text is gathered in a reusable chunk written to the stream when
+         * full, on flush and on destruction.
+         * Floating point values are written according to the
+         * TextOutputOptions read on construction.
+         */
+        class opengeode_io_image_api TextWriter
+        {
+        public:
+            explicit TextWriter( std::ostream& stream );
+            ~TextWriter();
+
+            TextWriter& operator<<( std::string_view text )
+            {
+                buffer_.append( text );
+                return check_chunk();
+            }
+
+            TextWriter& operator<<( const char* text )
+            {
+                return *this << std::string_view{ text };
+            }
+
+            TextWriter& operator<<( const std::string& text )
+            {
+                return *this << std::string_view{ text };
+            }
+
+            TextWriter& operator<<( char character )
+            {
+                buffer_.push_back( character );
+                return check_chunk();
+            }
+
+            TextWriter& operator<<( double value )
+            {
+                append_number( buffer_, value, significant_digits_ );
+                return check_chunk();
+            }
+
+            TextWriter& operator<<( float value )
+            {
+                append_number( buffer_, value, significant_digits_ );
+                return check_chunk();
+            }
+
+            template < typename T,
+                typename = std::enable_if_t< std::is_integral_v< T > > >
+            TextWriter& operator<<( T value )
+            {
+                append_number( buffer_, value );
+                return check_chunk();
+            }
+
+            /*!
+             * Write the point coordinates separated by spaces
+             */
+            template < index_t dimension >
+            TextWriter& operator<<( const Point< dimension >& point )
+            {
+                for( const auto d : LRange{ dimension } )
+                {
+                    if( d != 0 )
+                    {
+                        buffer_.push_back( ' ' );
+                    }
+                    append_number(
+                        buffer_, point.value( d ), significant_digits_ );
+                }
+                return check_chunk();
+            }
+
+            /*!
+             * Write the buffered text to the stream and flush it
+             */
+            void flush();
+
+        private:
+            TextWriter& check_chunk()
+            {
+                if( buffer_.size() >= CHUNK_SIZE )
+                {
+                    write_chunk();
+                }
+                return *this;
+            }
+
+            void write_chunk();
+
+        private:
+            static constexpr size_t CHUNK_SIZE{ 65536 };
+
+            std::ostream& stream_;
+            std::string buffer_;
+            local_index_t significant_digits_;
+        };
+    } // namespace detail
+} // namespace geode
@@ -23,6 +23,9 @@
 
 #pragma once
 
+#include <array>
+#include <string>
+
 #include <geode/geometry/point.hpp>
 
 #include <geode/io/image/detail/vtk_output.hpp>
@@ -43,10 +46,41 @@ namespace geode
             {
             }
 
-            pugi::xml_node write_image_header( pugi::xml_node& piece,
-                const std::array< index_t, dimension >& extent )
+            /*!
+             * Number of values in each direction of the written image
+             */
+            virtual std::array< index_t, dimension > extent() const = 0;
+
+            /*!
+             * Hook to add attributes (e.g. Origin, Spacing) to the ImageData
+             * element
+             */
+            virtual void write_image_attributes() {}
+
+            /*!
+             * Write the PointData and CellData elements of the piece
+             */
+            virtual void write_piece_data() = 0;
+
+        private:
+            void write_vtk_object_attributes() final
+            {
+                this->xml().add_attribute( "WholeExtent", extent_string() );
+                write_image_attributes();
+            }
+
+            void write_piece() final
+            {
+                auto& xml = this->xml();
+                xml.start_element( "Piece" );
+                xml.add_attribute( "Extent", extent_string() );
+                write_piece_data();
+                xml.end_element();
+            }
+
+            std::string extent_string() const
             {
-                auto image = piece.parent();
+                const auto image_extent = extent();
                 std::string extent_str;
                 for( const auto d : LRange{ dimension } )
                 {
@@ -54,17 +88,13 @@ namespace geode
                     {
                         absl::StrAppend( &extent_str, " " );
                     }
-                    absl::StrAppend( &extent_str, "0 ", extent[d] - 1 );
+                    absl::StrAppend( &extent_str, "0 ", image_extent[d] - 1 );
                 }
                 if( dimension == 2 )
                 {
                     absl::StrAppend( &extent_str, " 0 0" );
                 }
-                image.append_attribute( "WholeExtent" )
-                    .set_value( extent_str.c_str() );
-                piece.append_attribute( "Extent" )
-                    .set_value( extent_str.c_str() );
-                return image;
+                return extent_str;
             }
         };
     } // namespace detail
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <absl/types/span.h>
+
+#include <geode/io/image/common.hpp>
+#include <geode/io/image/vtk_output_options.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * Block compressor of the VTK XML binary data, as named by the
+         * compressor attribute of the VTKFile element.
+         * Each block is an independent compressed stream.
+         */
+        class opengeode_io_image_api VTKCompressor
+        {
+        public:
+            explicit VTKCompressor( VTK_COMPRESSOR type ) : type_{ type } {}
+
+            /*!
+             * Compressor of the given VTK name, an empty name meaning no
+             * compression.
+             * @exception OpenGeodeException if the compressor is not supported
+             */
+            [[nodiscard]] static VTKCompressor from_vtk_name(
+                std::string_view name );
+
+            [[nodiscard]] std::string_view vtk_name() const;
+
+            [[nodiscard]] VTK_COMPRESSOR type() const
+            {
+                return type_;
+            }
+
+            [[nodiscard]] bool is_compressed() const
+            {
+                return type_ != VTK_COMPRESSOR::none;
+            }
+
+            /*!
+             * Decompress a block straight into the given output, whose size
+             * should be the exact decompressed size.
+             * @exception OpenGeodeException if the block cannot be
+             * decompressed into the output
+             */
+            void decompress_block(
+                std::string_view block, absl::Span< char > output ) const;
+
+            /*!
+             * Append the compressed bytes to the output.
+             * @return the size of the compressed block.
+             */
+            size_t compress_block(
+                std::string_view bytes, std::string& output ) const;
+
+            /*!
+             * Append the bytes compressed by independent blocks of the given
+             * size, the last one being smaller. Blocks are compressed
+             * concurrently.
+             * @return the compressed size of each block.
+             */
+            std::vector< size_t > compress_blocks( std::string_view bytes,
+                size_t block_size,
+                std::string& output ) const;
+
+        private:
+            VTK_COMPRESSOR type_;
+        };
+    } // namespace detail
+} // namespace geode
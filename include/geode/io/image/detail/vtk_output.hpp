@@ -25,41 +25,158 @@
 
 #include <geode/io/image/common.hpp>
 
+#include <array>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
-#include <pugixml.hpp>
+#include <async++.h>
 
+#include <absl/algorithm/container.h>
+#include <absl/container/fixed_array.h>
+#include <absl/strings/str_cat.h>
+
+#include <geode/basic/attribute.hpp>
 #include <geode/basic/attribute_manager.hpp>
 
+#include <geode/io/image/detail/base64.hpp>
+#include <geode/io/image/detail/text_writer.hpp>
+#include <geode/io/image/detail/vtk_compressor.hpp>
+#include <geode/io/image/detail/vtk_xml_writer.hpp>
+#include <geode/io/image/text_output_options.hpp>
+#include <geode/io/image/vtk_output_options.hpp>
+
 namespace geode
 {
     namespace detail
     {
+        /*!
+         * Name of the VTK DataArray type storing values of type T
+         */
+        template < typename T >
+        constexpr std::string_view vtk_type_name()
+        {
+            static_assert( std::is_arithmetic_v< T > );
+            static_assert( sizeof( T ) <= 8 );
+            constexpr auto is_signed = std::is_signed_v< T >;
+            if constexpr( std::is_floating_point_v< T > )
+            {
+                return sizeof( T ) == 4 ? "Float32" : "Float64";
+            }
+            else if constexpr( sizeof( T ) == 1 )
+            {
+                return is_signed ? "Int8" : "UInt8";
+            }
+            else if constexpr( sizeof( T ) == 2 )
+            {
+                return is_signed ? "Int16" : "UInt16";
+            }
+            else if constexpr( sizeof( T ) == 4 )
+            {
+                return is_signed ? "Int32" : "UInt32";
+            }
+            else
+            {
+                return is_signed ? "Int64" : "UInt64";
+            }
+        }
+
+        /*!
+         * Streaming writer of a VTK XML file: XML elements and DataArray
+         * values are written to the file as they are generated, by chunks.
+         * Appended values are encoded once, when their DataArray element is
+         * written, and kept until the AppendedData section is written.
+         */
         template < typename Mesh >
         class VTKOutputImpl
         {
         public:
             void write_file()
             {
-                auto root = write_root_attributes();
-                write_vtk_object( root );
-                document_.save( file_ );
+                start_root_element( xml_, type_ );
+                xml_.start_element( type_ );
+                write_vtk_object_attributes();
+                write_piece();
+                xml_.end_element();
+                write_appended_data();
+                xml_.end_element();
+                OpenGeodeIOImageException::check_exception( file_.good(),
+                    nullptr, OpenGeodeException::TYPE::data,
+                    "[VTKOutput] Error while writing file: ", filename_ );
+            }
+
+            /*!
+             * Write a partitioned file (.pvtu, .pvtp) referencing the given
+             * piece files. The written file of this output is one of the
+             * pieces: its arrays are declared in the partitioned file.
+             */
+            void write_partitioned_file( std::string_view filename,
+                absl::Span< const std::string > sources ) const
+            {
+                std::ofstream file{ to_string( filename ), std::ios::binary };
+                OpenGeodeIOImageException::check_exception( file.good(),
+                    nullptr, OpenGeodeException::TYPE::data,
+                    "[VTKOutput] Error while writing file: ", filename );
+                VTKXMLWriter xml{ file };
+                const auto partitioned_type = absl::StrCat( "P", type_ );
+                start_root_element( xml, partitioned_type );
+                xml.start_element( partitioned_type );
+                xml.add_attribute( "GhostLevel", 0 );
+                for( const std::string_view section :
+                    { "PointData", "CellData", "Points" } )
+                {
+                    xml.start_element( absl::StrCat( "P", section ) );
+                    for( const auto& declaration : declared_arrays_ )
+                    {
+                        if( declaration.section != section )
+                        {
+                            continue;
+                        }
+                        xml.start_element( "PDataArray" );
+                        xml.add_attribute( "type", declaration.type );
+                        xml.add_attribute( "Name", declaration.name );
+                        xml.add_attribute(
+                            "NumberOfComponents", declaration.nb_components );
+                        xml.end_element();
+                    }
+                    xml.end_element();
+                }
+                for( const auto& source : sources )
+                {
+                    xml.start_element( "Piece" );
+                    xml.add_attribute( "Source", source );
+                    xml.end_element();
+                }
+                xml.end_element();
+                xml.end_element();
             }
 
         protected:
             VTKOutputImpl(
                 std::string_view filename, const Mesh& mesh, const char* type )
                 : filename_{ filename },
-                  file_{ to_string( filename ) },
+                  file_{ to_string( filename ), std::ios::binary },
+                  xml_{ file_ },
                   mesh_( mesh ),
-                  type_{ type }
+                  type_{ type },
+                  options_{ vtk_output_options() },
+                  significant_digits_{
+                      text_output_options().significant_digits },
+                  compressor_{ options_.format == VTK_DATA_FORMAT::ascii
+                                   ? VTK_COMPRESSOR::none
+                                   : options_.compressor }
             {
                 OpenGeodeIOImageException::check_exception( file_.good(),
                     nullptr, OpenGeodeException::TYPE::data,
                     "[VTKOutput] Error while writing file: ", filename );
             }
 
-            virtual ~VTKOutputImpl() {}
+            virtual ~VTKOutputImpl() = default;
 
             const Mesh& mesh() const
             {
@@ -71,91 +188,739 @@ namespace geode
                 return filename_;
             }
 
-            void write_attributes( pugi::xml_node& attribute_node,
-                const AttributeManager& manager ) const
+            VTKXMLWriter& xml()
+            {
+                return xml_;
+            }
+
+            const VTKOutputOptions& options() const
+            {
+                return options_;
+            }
+
+            /*!
+             * Write a DataArray of every genericable attribute into the
+             * current element
+             */
+            void write_attributes( const AttributeManager& manager )
             {
                 absl::FixedArray< index_t > elements( manager.nb_elements() );
                 absl::c_iota( elements, 0 );
-                write_attributes( attribute_node, manager, elements );
+                write_attributes( manager, elements );
             }
 
-            void write_attributes( pugi::xml_node& attribute_node,
-                const AttributeManager& manager,
-                absl::Span< const index_t > elements ) const
+            /*!
+             * Attribute values are gathered concurrently, by batches of at
+             * most one attribute per thread and of bounded size, then
+             * written in the order of the attribute names.
+             */
+            void write_attributes( const AttributeManager& manager,
+                absl::Span< const index_t > elements )
             {
-                for( const auto& name : manager.attribute_names() )
+                const auto names = manager.attribute_names();
+                const auto max_batch_size = static_cast< size_t >(
+                    std::max( std::thread::hardware_concurrency(), 1u ) );
+                std::vector< std::optional< AttributeDataArray > > arrays;
+                for( size_t start = 0; start < names.size(); )
                 {
-                    const auto attribute =
-                        manager.find_generic_attribute( name );
-                    if( !attribute || !attribute->is_genericable() )
+                    auto end = start;
+                    size_t batch_bytes{ 0 };
+                    while( end < names.size()
+                           && end - start < max_batch_size )
                     {
-                        continue;
+                        const auto nb_bytes = attribute_values_size(
+                            manager, names[end], elements.size() );
+                        if( end > start
+                            && batch_bytes + nb_bytes > ATTRIBUTE_BATCH_SIZE )
+                        {
+                            break;
+                        }
+                        batch_bytes += nb_bytes;
+                        end++;
                     }
-                    auto data_array = write_attribute_header(
-                        attribute_node, name, attribute->nb_items() );
-                    auto min = std::numeric_limits< float >::max();
-                    auto max = std::numeric_limits< float >::lowest();
-                    std::string values;
-                    for( const auto e : elements )
+                    arrays.clear();
+                    arrays.resize( end - start );
+                    async::parallel_for( async::irange( start, end ),
+                        [this, &manager, &names, &elements, &arrays,
+                            start]( size_t a ) {
+                            arrays[a - start] =
+                                gather_attribute( manager, names[a], elements );
+                        } );
+                    for( auto& array : arrays )
                     {
-                        for( const auto i : LRange{ attribute->nb_items() } )
+                        if( array )
                         {
-                            const auto value =
-                                attribute->generic_item_value( e, i );
-                            absl::StrAppend( &values, value, " " );
-                            min = std::min( min, value );
-                            max = std::max( max, value );
+                            write_attribute_data_array( array.value() );
                         }
                     }
-                    data_array.append_attribute( "RangeMin" ).set_value( min );
-                    data_array.append_attribute( "RangeMax" ).set_value( max );
-                    data_array.text().set( values.c_str() );
+                    start = end;
                 }
             }
 
-            pugi::xml_node write_attribute_header(
-                pugi::xml_node& attribute_node,
+            /*!
+             * Start a DataArray element in the current element. Other
+             * attributes may be added before writing its values with
+             * write_data_array.
+             */
+            void start_data_array( std::string_view type,
                 std::string_view name,
-                local_index_t nb_components ) const
+                local_index_t nb_components = 1 )
+            {
+                auto& xml = this->xml();
+                const auto section = xml.current_element();
+                if( section == "PointData" || section == "CellData"
+                    || section == "Points" )
+                {
+                    declared_arrays_.push_back( { std::string{ section },
+                        std::string{ type }, std::string{ name },
+                        nb_components } );
+                }
+                xml.start_element( "DataArray" );
+                xml.add_attribute( "type", type );
+                xml.add_attribute( "Name", name );
+                xml.add_attribute( "NumberOfComponents", nb_components );
+            }
+
+            /*!
+             * Write the values of the current DataArray and end it. Values
+             * are written either as text or as binary values, inline or in
+             * the AppendedData section, according to the output options.
+             * Binary values are compressed by blocks when a compressor is
+             * set. The DataArray type should match T.
+             */
+            template < typename T >
+            void write_data_array( absl::Span< const T > values )
             {
-                auto data_array = attribute_node.append_child( "DataArray" );
-                data_array.append_attribute( "type" ).set_value( "Float64" );
-                data_array.append_attribute( "Name" ).set_value(
-                    to_string( name ).c_str() );
-                data_array.append_attribute( "format" ).set_value( "ascii" );
-                data_array.append_attribute( "NumberOfComponents" )
-                    .set_value( nb_components );
-                return data_array;
+                if( options_.format == VTK_DATA_FORMAT::ascii )
+                {
+                    xml_.add_attribute( "format", "ascii" );
+                    write_ascii_values( values );
+                    xml_.end_element();
+                    return;
+                }
+                const std::string_view bytes{
+                    reinterpret_cast< const char* >( values.data() ),
+                    values.size() * sizeof( T )
+                };
+                if( options_.format == VTK_DATA_FORMAT::binary )
+                {
+                    xml_.add_attribute( "format", "binary" );
+                    write_binary_values(
+                        bytes, [this]( std::string_view data ) {
+                            xml_.add_text( data );
+                        } );
+                }
+                else
+                {
+                    xml_.add_attribute( "format", "appended" );
+                    xml_.add_attribute( "offset", appended_data_.size() );
+                    write_binary_values(
+                        bytes, [this]( std::string_view data ) {
+                            appended_data_.append( data );
+                        } );
+                }
+                xml_.end_element();
+            }
+
+            /*!
+             * Write a DataArray of indices (e.g. connectivity or offsets)
+             * into the current element, with its range. Indices are written
+             * as Int32 if compact indices are enabled and they all fit, as
+             * Int64 otherwise.
+             */
+            void write_index_data_array( std::string_view name,
+                absl::Span< const int64_t > indices,
+                local_index_t nb_components = 1 )
+            {
+                int64_t min{ 0 };
+                int64_t max{ 0 };
+                if( !indices.empty() )
+                {
+                    const auto range = absl::c_minmax_element( indices );
+                    min = *range.first;
+                    max = *range.second;
+                }
+                const auto fits_int32 =
+                    min >= std::numeric_limits< int32_t >::min()
+                    && max <= std::numeric_limits< int32_t >::max();
+                const auto compact = options_.compact_indices && fits_int32;
+                start_data_array(
+                    compact ? "Int32" : "Int64", name, nb_components );
+                if( !indices.empty() )
+                {
+                    xml().add_attribute( "RangeMin", min );
+                    xml().add_attribute( "RangeMax", max );
+                }
+                if( !compact )
+                {
+                    write_data_array( indices );
+                    return;
+                }
+                std::vector< int32_t > compact_indices(
+                    indices.begin(), indices.end() );
+                write_data_array< int32_t >( compact_indices );
+            }
+
+            /*!
+             * Write a DataArray of coordinates (e.g. points or texture
+             * coordinates) into the current element, as Float32 if single
+             * precision is enabled, as Float64 otherwise.
+             */
+            void write_coordinates_data_array( std::string_view name,
+                local_index_t nb_components,
+                absl::Span< const double > values,
+                double min,
+                double max )
+            {
+                if( !options_.single_precision )
+                {
+                    start_data_array( "Float64", name, nb_components );
+                    xml().add_attribute( "RangeMin", min );
+                    xml().add_attribute( "RangeMax", max );
+                    write_data_array( values );
+                    return;
+                }
+                start_data_array( "Float32", name, nb_components );
+                xml().add_attribute( "RangeMin", static_cast< float >( min ) );
+                xml().add_attribute( "RangeMax", static_cast< float >( max ) );
+                std::vector< float > single_values(
+                    values.begin(), values.end() );
+                write_data_array< float >( single_values );
             }
 
         private:
-            pugi::xml_node write_root_attributes()
+            /*!
+             * Component type and number of components of an attribute
+             * value, either a scalar or a fixed size array of scalars
+             */
+            template < typename T >
+            struct AttributeValueComponents
+            {
+                using Component = T;
+                static constexpr local_index_t nb_components{ 1 };
+
+                static const T& component( const T& value, local_index_t )
+                {
+                    return value;
+                }
+            };
+
+            template < typename T, size_t N >
+            struct AttributeValueComponents< std::array< T, N > >
+            {
+                using Component = T;
+                static constexpr local_index_t nb_components{ N };
+
+                static const T& component(
+                    const std::array< T, N >& value, local_index_t c )
+                {
+                    return value[c];
+                }
+            };
+
+            /*!
+             * DataArray of an attribute, whose values are gathered before
+             * being written
+             */
+            struct AttributeDataArray
+            {
+                std::string_view type;
+                std::string name;
+                local_index_t nb_components;
+                /*! Range bounds, empty for an empty array */
+                std::string range_min;
+                std::string range_max;
+                std::function< void() > write_values;
+            };
+
+
+            /*!
+             * Upper bound of the gathered values size of an attribute
+             */
+            static size_t attribute_values_size(
+                const AttributeManager& manager,
+                std::string_view name,
+                size_t nb_elements )
             {
-                auto root = document_.append_child( "VTKFile" );
-                root.append_attribute( "type" ).set_value( type_ );
-                root.append_attribute( "version" ).set_value( "1.0" );
-                root.append_attribute( "byte_order" )
-                    .set_value( "LittleEndian" );
-                root.append_attribute( "header_type" ).set_value( "UInt32" );
-                root.append_attribute( "compressor" )
-                    .set_value( "vtkZLibDataCompressor" );
-                return root;
+                const auto attribute = manager.find_generic_attribute( name );
+                if( !attribute )
+                {
+                    return 0;
+                }
+                const auto nb_items =
+                    attribute->is_genericable() ? attribute->nb_items() : 1;
+                return nb_elements * nb_items * sizeof( double );
             }
 
-            void write_vtk_object( pugi::xml_node& root )
+            /*!
+             * Gather the attribute with the VTK type matching its value
+             * type if it is a native scalar type or a fixed size array of 2
+             * or 3 of them, or else through its generic values if it is
+             * genericable.
+             */
+            std::optional< AttributeDataArray > gather_attribute(
+                const AttributeManager& manager,
+                std::string_view name,
+                absl::Span< const index_t > elements )
             {
-                auto object = root.append_child( type_ );
-                write_piece( object );
+                const auto attribute = manager.find_generic_attribute( name );
+                if( !attribute )
+                {
+                    return std::nullopt;
+                }
+                if( auto array = gather_native_attribute< bool, signed char,
+                        unsigned char, short, unsigned short, int,
+                        unsigned int, long, unsigned long, long long,
+                        unsigned long long, float, double >(
+                        *attribute, name, elements ) )
+                {
+                    return array;
+                }
+                if( attribute->is_genericable() )
+                {
+                    return gather_generic_attribute(
+                        *attribute, name, elements );
+                }
+                return std::nullopt;
             }
 
-            virtual void write_piece( pugi::xml_node& object ) = 0;
+            template < typename... Scalars >
+            std::optional< AttributeDataArray > gather_native_attribute(
+                const AttributeBase& attribute,
+                std::string_view name,
+                absl::Span< const index_t > elements )
+            {
+                return gather_first_typed_attribute< Scalars...,
+                    std::array< Scalars, 2 >..., std::array< Scalars, 3 >... >(
+                    attribute, name, elements );
+            }
+
+            template < typename Value, typename... Others >
+            std::optional< AttributeDataArray > gather_first_typed_attribute(
+                const AttributeBase& attribute,
+                std::string_view name,
+                absl::Span< const index_t > elements )
+            {
+                if( auto array = gather_typed_attribute< Value >(
+                        attribute, name, elements ) )
+                {
+                    return array;
+                }
+                if constexpr( sizeof...( Others ) > 0 )
+                {
+                    return gather_first_typed_attribute< Others... >(
+                        attribute, name, elements );
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+
+            template < typename Value >
+            std::optional< AttributeDataArray > gather_typed_attribute(
+                const AttributeBase& attribute,
+                std::string_view name,
+                absl::Span< const index_t > elements )
+            {
+                const auto* typed_attribute =
+                    dynamic_cast< const ReadOnlyAttribute< Value >* >(
+                        &attribute );
+                if( !typed_attribute )
+                {
+                    return std::nullopt;
+                }
+                using Components = AttributeValueComponents< Value >;
+                using Scalar = typename Components::Component;
+                // Booleans are written as bytes
+                using Component = std::conditional_t<
+                    std::is_same_v< Scalar, bool >, uint8_t, Scalar >;
+                if constexpr( std::is_same_v< Component, double > )
+                {
+                    if( options_.single_precision )
+                    {
+                        return gather_attribute_values< float >( name,
+                            "Float32", Components::nb_components, elements,
+                            [typed_attribute](
+                                index_t element, local_index_t c ) {
+                                return static_cast< float >(
+                                    Components::component(
+                                        typed_attribute->value( element ),
+                                        c ) );
+                            } );
+                    }
+                }
+                return gather_attribute_values< Component >( name,
+                    vtk_type_name< Component >(), Components::nb_components,
+                    elements,
+                    [typed_attribute]( index_t element, local_index_t c ) {
+                        return static_cast< Component >(
+                            Components::component(
+                                typed_attribute->value( element ), c ) );
+                    } );
+            }
+
+            /*!
+             * Gather any other genericable attribute (e.g. colors or
+             * points) through its generic float values
+             */
+            AttributeDataArray gather_generic_attribute(
+                const AttributeBase& attribute,
+                std::string_view name,
+                absl::Span< const index_t > elements )
+            {
+                return gather_attribute_values< float >( name, "Float32",
+                    attribute.nb_items(), elements,
+                    [&attribute]( index_t element, local_index_t item ) {
+                        return attribute.generic_item_value( element, item );
+                    } );
+            }
+
+            /*!
+             * Gather the attribute components of the elements and their
+             * range. Large attributes are gathered by concurrent chunks of
+             * elements, each one computing its own value range.
+             */
+            template < typename T, typename ComponentGetter >
+            AttributeDataArray gather_attribute_values( std::string_view name,
+                std::string_view type,
+                local_index_t nb_components,
+                absl::Span< const index_t > elements,
+                const ComponentGetter& component )
+            {
+                const auto nb_chunks =
+                    ( elements.size() + ATTRIBUTE_CHUNK_SIZE - 1 )
+                    / ATTRIBUTE_CHUNK_SIZE;
+                std::vector< T > values( elements.size() * nb_components );
+                absl::FixedArray< std::pair< T, T > > ranges( nb_chunks,
+                    { std::numeric_limits< T >::max(),
+                        std::numeric_limits< T >::lowest() } );
+                async::parallel_for( async::irange( size_t{ 0 }, nb_chunks ),
+                    [&]( size_t chunk ) {
+                        auto& range = ranges[chunk];
+                        const auto start = chunk * ATTRIBUTE_CHUNK_SIZE;
+                        const auto end = std::min(
+                            start + ATTRIBUTE_CHUNK_SIZE, elements.size() );
+                        for( auto e = start; e < end; e++ )
+                        {
+                            for( const auto c : LRange{ nb_components } )
+                            {
+                                const auto value = component( elements[e], c );
+                                values[e * nb_components + c] = value;
+                                range.first = std::min( range.first, value );
+                                range.second = std::max( range.second, value );
+                            }
+                        }
+                    } );
+                auto min = std::numeric_limits< T >::max();
+                auto max = std::numeric_limits< T >::lowest();
+                for( const auto& range : ranges )
+                {
+                    min = std::min( min, range.first );
+                    max = std::max( max, range.second );
+                }
+                AttributeDataArray array;
+                array.type = type;
+                array.name = to_string( name );
+                array.nb_components = nb_components;
+                // Empty arrays have no range
+                if( !values.empty() )
+                {
+                    append_range_bound( array.range_min, min );
+                    append_range_bound( array.range_max, max );
+                }
+                array.write_values = [this, values = std::move( values )] {
+                    write_data_array< T >( values );
+                };
+                return array;
+            }
+
+            template < typename T >
+            static void append_range_bound( std::string& text, T value )
+            {
+                if constexpr( std::is_floating_point_v< T > )
+                {
+                    // Shortest text read back as the exact same value
+                    append_number( text, value, 0 );
+                }
+                else
+                {
+                    append_number( text, value );
+                }
+            }
+
+            void write_attribute_data_array( AttributeDataArray& array )
+            {
+                start_data_array( array.type, array.name, array.nb_components );
+                if( !array.range_min.empty() )
+                {
+                    xml().add_attribute( "RangeMin", array.range_min );
+                    xml().add_attribute( "RangeMax", array.range_max );
+                }
+                array.write_values();
+                // Gathered values are released as soon as they are written
+                array.write_values = nullptr;
+            }
+
+            struct DataArrayDeclaration
+            {
+                std::string section;
+                std::string type;
+                std::string name;
+                local_index_t nb_components;
+            };
+
+            /*!
+             * Base64 encoder of a byte stream given by successive parts,
+             * giving the encoded text to the sink by chunks
+             */
+            template < typename Sink >
+            class Base64Stream
+            {
+            public:
+                explicit Base64Stream( const Sink& sink ) : sink_( sink ) {}
+
+                void write( std::string_view bytes )
+                {
+                    if( !pending_.empty() )
+                    {
+                        const auto nb_completing =
+                            std::min( bytes.size(), 3 - pending_.size() );
+                        pending_.append( bytes.data(), nb_completing );
+                        bytes.remove_prefix( nb_completing );
+                        if( pending_.size() < 3 )
+                        {
+                            return;
+                        }
+                        encode( pending_ );
+                        pending_.clear();
+                    }
+                    const auto nb_grouped = bytes.size() - bytes.size() % 3;
+                    for( size_t start = 0; start < nb_grouped;
+                         start += BASE64_CHUNK_SIZE )
+                    {
+                        const auto nb_chunk_bytes =
+                            std::min( BASE64_CHUNK_SIZE, nb_grouped - start );
+                        encode( bytes.substr( start, nb_chunk_bytes ) );
+                    }
+                    pending_.assign( bytes.substr( nb_grouped ) );
+                }
+
+                /*!
+                 * Encode the last bytes, padded, ending the stream
+                 */
+                void flush()
+                {
+                    if( !pending_.empty() )
+                    {
+                        encode( pending_ );
+                        pending_.clear();
+                    }
+                }
+
+            private:
+                void encode( std::string_view bytes )
+                {
+                    encoded_.clear();
+                    encode_base64( bytes, encoded_ );
+                    sink_( encoded_ );
+                }
+
+            private:
+                const Sink& sink_;
+                std::string pending_;
+                std::string encoded_;
+            };
+
+            static constexpr size_t ATTRIBUTE_CHUNK_SIZE{ 65536 };
+            static constexpr size_t ATTRIBUTE_BATCH_SIZE{ 64 * 1024 * 1024 };
+            static constexpr size_t ASCII_CHUNK_SIZE{ 4096 };
+            static constexpr size_t BASE64_CHUNK_SIZE{ 3 * 16384 };
+
+            void start_root_element(
+                VTKXMLWriter& xml, std::string_view type ) const
+            {
+                xml.start_element( "VTKFile" );
+                xml.add_attribute( "type", type );
+                xml.add_attribute( "version", "1.0" );
+                xml.add_attribute( "byte_order", "LittleEndian" );
+                xml.add_attribute( "header_type", "UInt64" );
+                if( compressor_.is_compressed() )
+                {
+                    xml.add_attribute( "compressor", compressor_.vtk_name() );
+                }
+            }
+
+            /*!
+             * Hook to add attributes to the VTK object element (e.g.
+             * ImageData) before its pieces are written
+             */
+            virtual void write_vtk_object_attributes() {}
+
+            virtual void write_piece() = 0;
+
+            template < typename T >
+            void write_ascii_values( absl::Span< const T > values )
+            {
+                if( values.empty() )
+                {
+                    // Element of an empty array is not self-closed
+                    xml().add_text( {} );
+                    return;
+                }
+                std::string text;
+                for( size_t start = 0; start < values.size();
+                     start += ASCII_CHUNK_SIZE )
+                {
+                    text.clear();
+                    for( const auto value :
+                        values.subspan( start, ASCII_CHUNK_SIZE ) )
+                    {
+                        if constexpr( std::is_floating_point_v< T > )
+                        {
+                            append_number( text, value, significant_digits_ );
+                        }
+                        else
+                        {
+                            append_number( text, value );
+                        }
+                        text.push_back( ' ' );
+                    }
+                    xml().add_text( text );
+                }
+            }
+
+            /*!
+             * Give the header and the binary values, compressed or not and
+             * base64 encoded or not, to the sink by successive chunks
+             */
+            template < typename Sink >
+            void write_binary_values(
+                std::string_view bytes, const Sink& sink ) const
+            {
+                if( compressor_.is_compressed() )
+                {
+                    write_compressed_values( bytes, sink );
+                    return;
+                }
+                const uint64_t nb_bytes = bytes.size();
+                const std::string_view header{
+                    reinterpret_cast< const char* >( &nb_bytes ),
+                    sizeof( nb_bytes )
+                };
+                if( options_.format == VTK_DATA_FORMAT::raw_appended )
+                {
+                    sink( header );
+                    sink( bytes );
+                    return;
+                }
+                // Header and values form a single base64 stream
+                Base64Stream< Sink > stream{ sink };
+                stream.write( header );
+                stream.write( bytes );
+                stream.flush();
+            }
+
+            /*!
+             * Number of blocks compressed concurrently at once
+             */
+            static size_t nb_concurrent_blocks()
+            {
+                return 4
+                       * static_cast< size_t >( std::max(
+                           std::thread::hardware_concurrency(), 1u ) );
+            }
+
+            /*!
+             * Compress the bytes by groups of blocks, once, then give the
+             * header and the compressed blocks to the sink
+             */
+            template < typename Sink >
+            void write_compressed_values(
+                std::string_view bytes, const Sink& sink ) const
+            {
+                const size_t block_size = options_.compression_block_size;
+                const auto group_size = nb_concurrent_blocks() * block_size;
+                std::vector< std::string > groups;
+                std::vector< size_t > blocks_size;
+                for( size_t start = 0; start < bytes.size();
+                     start += group_size )
+                {
+                    auto& blocks = groups.emplace_back();
+                    const auto group_blocks_size = compressor_.compress_blocks(
+                        bytes.substr( start, group_size ), block_size, blocks );
+                    blocks_size.insert( blocks_size.end(),
+                        group_blocks_size.begin(), group_blocks_size.end() );
+                }
+                // Header is [nb blocks, block size, last block size,
+                // compressed block sizes...], followed by compressed blocks
+                std::vector< uint64_t > header;
+                header.reserve( 3 + blocks_size.size() );
+                header.push_back( blocks_size.size() );
+                header.push_back( block_size );
+                header.push_back( bytes.size() % block_size );
+                header.insert(
+                    header.end(), blocks_size.begin(), blocks_size.end() );
+                const std::string_view header_bytes{
+                    reinterpret_cast< const char* >( header.data() ),
+                    header.size() * sizeof( uint64_t )
+                };
+                if( options_.format == VTK_DATA_FORMAT::raw_appended )
+                {
+                    sink( header_bytes );
+                    for( const auto& blocks : groups )
+                    {
+                        sink( blocks );
+                    }
+                    return;
+                }
+                // Compressed header is encoded separately from the blocks
+                Base64Stream< Sink > header_stream{ sink };
+                header_stream.write( header_bytes );
+                header_stream.flush();
+                Base64Stream< Sink > blocks_stream{ sink };
+                for( const auto& blocks : groups )
+                {
+                    blocks_stream.write( blocks );
+                }
+                blocks_stream.flush();
+            }
+
+            /*!
+             * Write the AppendedData element with the values kept for the
+             * appended DataArrays. Raw binary values are not valid XML:
+             * they are written as is just before the root closing tag.
+             */
+            void write_appended_data()
+            {
+                if( appended_data_.empty() )
+                {
+                    return;
+                }
+                xml_.start_element( "AppendedData" );
+                xml_.add_attribute( "encoding",
+                    options_.format == VTK_DATA_FORMAT::raw_appended
+                        ? "raw"
+                        : "base64" );
+                xml_.add_text( "\n\t\t_" );
+                xml_.add_text( appended_data_ );
+                xml_.add_text( "\n\t" );
+                xml_.end_element();
+                appended_data_.clear();
+                appended_data_.shrink_to_fit();
+            }
 
         private:
             std::string_view filename_;
             std::ofstream file_;
+            VTKXMLWriter xml_;
             const Mesh& mesh_;
-            pugi::xml_document document_;
             const char* type_;
+            VTKOutputOptions options_;
+            local_index_t significant_digits_;
+            VTKCompressor compressor_;
+            std::vector< DataArrayDeclaration > declared_arrays_;
+            std::string appended_data_;
         };
     } // namespace detail
 } // namespace geode
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+
+#include <geode/io/image/common.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * Streaming writer of XML elements: every element, attribute and
+         * text is written to the output stream as soon as it is added,
+         * without building a document in memory.
+         * Attributes of an element should be added before its children and
+         * its text.
+         */
+        class opengeode_io_image_api VTKXMLWriter
+        {
+        public:
+            explicit VTKXMLWriter( std::ostream& stream );
+
+            void start_element( std::string_view name );
+
+            void add_attribute( std::string_view name, std::string_view value );
+
+            void add_attribute( std::string_view name, double value );
+
+            void add_attribute( std::string_view name, float value );
+
+            template < typename T,
+                std::enable_if_t< std::is_integral_v< T >, int > = 0 >
+            void add_attribute( std::string_view name, T value )
+            {
+                if constexpr( sizeof( T ) == 1 )
+                {
+                    add_attribute(
+                        name, absl::StrCat( static_cast< int >( value ) ) );
+                }
+                else
+                {
+                    add_attribute( name, absl::StrCat( value ) );
+                }
+            }
+
+            /*!
+             * Append text to the current element. Text is written as is and
+             * should not contain XML markup.
+             */
+            void add_text( std::string_view text );
+
+            void end_element();
+
+            /*!
+             * Name of the innermost element not yet ended, empty if none
+             */
+            [[nodiscard]] std::string_view current_element() const;
+
+        private:
+            void close_start_tag();
+
+            void indent( size_t depth );
+
+        private:
+            std::ostream& stream_;
+            std::vector< std::string > elements_;
+            bool start_tag_open_{ false };
+            bool has_text_{ false };
+        };
+    } // namespace detail
+} // namespace geode
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <geode/io/image/common.hpp>
+
+namespace geode
+{
+    struct TextOutputOptions
+    {
+        /*!
+         * Number of significant digits of the floating point values written
+         * by the text outputs (.msh, .msh GiD, .node, ascii VTK DataArray).
+         * 0 writes the shortest text that is read back as the exact same
+         * value. Fewer digits give smaller files with rounded values.
+         */
+        local_index_t significant_digits{ 0 };
+    };
+
+    /*!
+     * Set the options used by the text outputs.
+     * Options are read when an output starts: they should not be modified
+     * while outputs are running.
+     */
+    void opengeode_io_image_api set_text_output_options(
+        const TextOutputOptions& options );
+
+    [[nodiscard]] TextOutputOptions opengeode_io_image_api
+        text_output_options();
+} // namespace geode
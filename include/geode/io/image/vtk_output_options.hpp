@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <geode/io/image/common.hpp>
+
+namespace geode
+{
+    /*!
+     * Encoding of the DataArray values written by the VTK XML outputs
+     */
+    enum struct VTK_DATA_FORMAT
+    {
+        /*! Whitespace separated values inside each DataArray, for debug */
+        ascii,
+        /*! Base64 encoded binary values inside each DataArray */
+        binary,
+        /*! Binary values gathered in a base64 encoded AppendedData section */
+        base64_appended,
+        /*! Binary values gathered in a raw AppendedData section */
+        raw_appended
+    };
+
+    /*!
+     * Compression of the binary DataArray values written by the VTK XML
+     * outputs. Ascii values are never compressed.
+     */
+    enum struct VTK_COMPRESSOR
+    {
+        none,
+        /*! vtkZLibDataCompressor */
+        zlib,
+        /*! vtkLZ4DataCompressor: fastest, lowest ratio */
+        lz4,
+        /*! vtkLZMADataCompressor: slowest, highest ratio */
+        lzma
+    };
+
+    /*!
+     * Layout of the faces of the general polyhedra (VTK_POLYHEDRON cells)
+     * written by the .vtu outputs
+     */
+    enum struct VTK_POLYHEDRON_FACES
+    {
+        /*! faces and faceoffsets arrays, read by every VTK version */
+        legacy,
+        /*!
+         * face_connectivity, face_offsets, polyhedron_to_faces and
+         * polyhedron_offsets arrays, introduced by VTK 9.4: more compact
+         * and faster to decode
+         */
+        vtk_9_4
+    };
+
+    struct VTKOutputOptions
+    {
+        VTK_DATA_FORMAT format{ VTK_DATA_FORMAT::raw_appended };
+
+        VTK_COMPRESSOR compressor{ VTK_COMPRESSOR::zlib };
+
+        /*!
+         * Number of uncompressed bytes per compressed block. Blocks are
+         * compressed concurrently.
+         */
+        index_t compression_block_size{ 32768 };
+
+        /*!
+         * Write connectivity and offset arrays as Int32 instead of Int64
+         * when all their values fit
+         */
+        bool compact_indices{ true };
+
+        /*!
+         * Write point coordinates, texture coordinates and double
+         * attributes as Float32 instead of Float64, losing precision for
+         * smaller files
+         */
+        bool single_precision{ false };
+
+        VTK_POLYHEDRON_FACES polyhedron_faces{ VTK_POLYHEDRON_FACES::legacy };
+
+        /*!
+         * Store the polyhedron (.vtu) or polygon (.vtp) adjacencies in a
+         * CellData array, so that inputs set them instead of computing
+         * them. Adjacencies are not stored in partitioned files.
+         */
+        bool adjacencies{ false };
+
+        /*!
+         * Number of piece files written by the partitioned outputs (.pvtu)
+         */
+        index_t nb_pieces{ 8 };
+    };
+
+    /*!
+     * Set the options used by the VTK XML outputs (.vtu, .pvtu, .vtp, .vti,
+     * .vtm).
+     * Options are read when an output starts: they should not be modified
+     * while outputs are running.
+     */
+    void opengeode_io_image_api set_vtk_output_options(
+        const VTKOutputOptions& options );
+
+    [[nodiscard]] VTKOutputOptions opengeode_io_image_api
+        vtk_output_options();
+} // namespace geode
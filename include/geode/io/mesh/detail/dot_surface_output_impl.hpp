@@ -30,6 +30,8 @@
 
 #include <geode/mesh/core/surface_edges.hpp>
 
+#include <geode/io/image/detail/text_writer.hpp>
+
 namespace geode
 {
     namespace detail
@@ -41,7 +43,8 @@ namespace geode
             DotSurfaceOutputImpl(
                 std::string_view filename, const Mesh& surface )
                 : filename_( filename ),
-                  file_( to_string( filename ) ),
+                  stream_( to_string( filename ) ),
+                  file_{ stream_ },
                   surface_( surface )
             {
                 surface_.enable_edges();
@@ -60,12 +63,14 @@ namespace geode
                           << ";\n";
                 }
                 file_ << "}\n";
-                file_.close();
+                file_.flush();
+                stream_.close();
             }
 
         private:
             std::string_view filename_;
-            std::ofstream file_;
+            std::ofstream stream_;
+            TextWriter file_;
             const Mesh& surface_;
         };
     } // namespace detail
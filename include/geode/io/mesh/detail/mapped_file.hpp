@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include <geode/basic/pimpl.hpp>
+
+#include <geode/io/mesh/common.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * Copy-on-write memory mapping of a whole file.
+         * Mapped bytes may be modified (e.g. by an in-place parser) without
+         * altering the file on disk: only the modified pages are copied.
+         */
+        class opengeode_io_mesh_api MappedFile
+        {
+        public:
+            explicit MappedFile( std::string_view filename );
+            MappedFile( MappedFile&& other );
+            ~MappedFile();
+
+            char* data();
+
+            const char* data() const;
+
+            size_t size() const;
+
+            std::string_view content() const
+            {
+                return { data(), size() };
+            }
+
+        private:
+            IMPLEMENTATION_MEMBER( impl_ );
+        };
+    } // namespace detail
+} // namespace geode
@@ -26,6 +26,8 @@
 #include <array>
 #include <fstream>
 
+#include <absl/container/fixed_array.h>
+
 #include <geode/basic/string.hpp>
 
 #include <geode/geometry/vector.hpp>
@@ -49,6 +51,17 @@ namespace geode
             {
             }
 
+            /*!
+             * Leave the raw appended PointData and CellData arrays out of
+             * the attributes, for them to be accessed with the
+             * VTIMappedArrays of the file. The file should have a single
+             * piece.
+             */
+            void skip_mapped_arrays()
+            {
+                map_arrays_ = true;
+            }
+
             struct GridAttributes
             {
                 GridAttributes()
@@ -127,18 +140,185 @@ namespace geode
             }
 
         private:
+            struct VTIPiece
+            {
+                std::vector< VTKDataArrayValues > point_data;
+                std::vector< VTKDataArrayValues > cell_data;
+            };
+
             void read_vtk_object( const pugi::xml_node& vtk_object ) final
             {
                 build_grid( vtk_object );
+                std::vector< pugi::xml_node > pieces;
                 for( const auto& piece : vtk_object.children( "Piece" ) )
                 {
-                    this->read_data( piece.child( "PointData" ), 0,
+                    pieces.push_back( piece );
+                }
+                // Only single piece files are accessed by VTIMappedArrays
+                OpenGeodeIOMeshException::check_exception(
+                    !map_arrays_ || pieces.size() == 1, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTIInput::read_vtk_object] Arrays of a multi-piece "
+                    "file cannot be mapped" );
+                if( this->options().parallel_pieces && pieces.size() > 1 )
+                {
+                    absl::FixedArray< VTIPiece > decoded_pieces(
+                        pieces.size() );
+                    async::parallel_for(
+                        async::irange( size_t{ 0 }, pieces.size() ),
+                        [&]( size_t p ) {
+                            decoded_pieces[p] = decode_piece( pieces[p] );
+                        } );
+                    for( const auto& piece : decoded_pieces )
+                    {
+                        store_piece( piece );
+                    }
+                    return;
+                }
+                for( const auto& piece : pieces )
+                {
+                    store_piece( decode_piece( piece ) );
+                }
+            }
+
+            bool skip_data_array( const pugi::xml_node& data ) const override
+            {
+                return map_arrays_ && this->has_raw_appended_data()
+                       && this->match(
+                           data.attribute( "format" ).value(), "appended" );
+            }
+
+            VTIPiece decode_piece( const pugi::xml_node& piece ) const
+            {
+                return { this->decode_data( piece.child( "PointData" ) ),
+                    this->decode_data( piece.child( "CellData" ) ) };
+            }
+
+            void store_piece( const VTIPiece& piece )
+            {
+                this->store_data( piece.point_data, 0,
+                    this->mesh().grid_vertex_attribute_manager() );
+                this->store_data(
+                    piece.cell_data, 0, this->mesh().cell_attribute_manager() );
+            }
+
+            void read_partitioned_file(
+                const pugi::xml_node& partitioned_object ) final
+            {
+                build_grid( partitioned_object );
+                const auto whole_extent =
+                    read_extent( partitioned_object, "WholeExtent" );
+                const auto readers = this->open_piece_readers();
+                std::vector< const VTIGridInputImpl* > piece_readers;
+                std::vector< pugi::xml_node > pieces;
+                for( const auto& reader : readers )
+                {
+                    // Piece readers are created by create_piece_reader(),
+                    // which returns readers of the same kind
+                    const auto& piece_reader =
+                        static_cast< const VTIGridInputImpl& >( *reader );
+                    for( const auto& piece : piece_reader.piece_nodes() )
+                    {
+                        piece_readers.push_back( &piece_reader );
+                        pieces.push_back( piece );
+                    }
+                }
+                absl::FixedArray< VTIPiece > decoded_pieces( pieces.size() );
+                const auto decode = [&]( size_t p ) {
+                    decoded_pieces[p] =
+                        piece_readers[p]->decode_piece( pieces[p] );
+                };
+                if( this->options().parallel_pieces )
+                {
+                    async::parallel_for(
+                        async::irange( size_t{ 0 }, pieces.size() ), decode );
+                }
+                else
+                {
+                    for( const auto p : Indices{ pieces } )
+                    {
+                        decode( p );
+                    }
+                }
+                for( const auto p : Indices{ pieces } )
+                {
+                    // Piece values are placed in the grid using the piece
+                    // extent, given in the whole extent
+                    const auto extent = read_extent( pieces[p], "Extent" );
+                    std::array< index_t, dimension > start;
+                    std::array< index_t, dimension > nb_vertices;
+                    for( const auto d : LRange{ dimension } )
+                    {
+                        OpenGeodeIOMeshException::check_exception(
+                            extent[2 * d] >= whole_extent[2 * d]
+                                && extent[2 * d] <= extent[2 * d + 1]
+                                && extent[2 * d + 1]
+                                       <= whole_extent[2 * d + 1],
+                            nullptr, OpenGeodeException::TYPE::data,
+                            "[VTIInput::read_partitioned_file] Piece extent "
+                            "is not included in the whole extent" );
+                        start[d] = static_cast< index_t >(
+                            extent[2 * d] - whole_extent[2 * d] );
+                        nb_vertices[d] = static_cast< index_t >(
+                            extent[2 * d + 1] - extent[2 * d] + 1 );
+                    }
+                    this->store_data(
+                        decoded_pieces[p].point_data,
+                        [&]( index_t v ) {
+                            return this->mesh().vertex_index(
+                                grid_indices( v, start, nb_vertices, 0 ) );
+                        },
                         this->mesh().grid_vertex_attribute_manager() );
-                    this->read_data( piece.child( "CellData" ), 0,
+                    this->store_data(
+                        decoded_pieces[p].cell_data,
+                        [&]( index_t c ) {
+                            return this->mesh().cell_index(
+                                grid_indices( c, start, nb_vertices, 1 ) );
+                        },
                         this->mesh().cell_attribute_manager() );
+                    decoded_pieces[p] = {};
                 }
             }
 
+            /*!
+             * Grid indices of the element of a piece, given its index in the
+             * piece and the piece vertex numbers along each direction.
+             * The shift is 0 for the vertices and 1 for the cells.
+             */
+            static std::array< index_t, dimension > grid_indices(
+                index_t element,
+                const std::array< index_t, dimension >& start,
+                const std::array< index_t, dimension >& nb_vertices,
+                index_t shift )
+            {
+                std::array< index_t, dimension > indices;
+                for( const auto d : LRange{ dimension } )
+                {
+                    const auto nb_elements =
+                        std::max( nb_vertices[d] - shift, index_t{ 1 } );
+                    indices[d] = start[d] + element % nb_elements;
+                    element /= nb_elements;
+                }
+                return indices;
+            }
+
+            static std::array< int, 6 > read_extent(
+                const pugi::xml_node& node, const char* attribute )
+            {
+                std::array< int, 6 > extent;
+                extent.fill( 0 );
+                const auto tokens =
+                    string_split( node.attribute( attribute ).value() );
+                for( const auto i : Indices{ tokens } )
+                {
+                    if( i < extent.size() )
+                    {
+                        extent[i] = string_to_int( tokens[i] );
+                    }
+                }
+                return extent;
+            }
+
             void is_vtk_object_loadable( const pugi::xml_node& vtk_object,
                 std::vector< Percentage >& percentages ) const final
             {
@@ -150,6 +330,9 @@ namespace geode
 
         protected:
             virtual void build_grid( const pugi::xml_node& vtk_object ) = 0;
+
+        private:
+            bool map_arrays_{ false };
         };
     } // namespace detail
 } // namespace geode
@@ -29,6 +29,7 @@
 
 #include <geode/mesh/core/grid.hpp>
 
+#include <geode/io/image/detail/text_writer.hpp>
 #include <geode/io/image/detail/vti_output_impl.hpp>
 
 namespace geode
@@ -46,33 +47,43 @@ namespace geode
             }
 
         private:
-            void write_piece( pugi::xml_node& object ) final
+            std::array< index_t, dimension > extent() const final
             {
-                auto piece = object.append_child( "Piece" );
                 std::array< index_t, dimension > extent;
                 for( const auto d : LRange{ dimension } )
                 {
                     extent[d] = this->mesh().nb_vertices_in_direction( d );
                 }
-                auto header_node = this->write_image_header( piece, extent );
-                write_header( header_node );
-                write_vertex_data( piece );
-                write_cell_data( piece );
+                return extent;
             }
 
-            void write_header( pugi::xml_node& header_node )
+            void write_piece_data() final
             {
+                write_vertex_data();
+                write_cell_data();
+            }
+
+            void write_image_attributes() final
+            {
+                auto& xml = this->xml();
                 const auto& coordinate_system =
                     this->mesh().grid_coordinate_system();
+                // Grid geometry is always written exactly
                 std::string origin_str;
-                absl::StrAppend(
-                    &origin_str, coordinate_system.origin().string() );
+                for( const auto d : LRange{ dimension } )
+                {
+                    if( d != 0 )
+                    {
+                        origin_str.push_back( ' ' );
+                    }
+                    append_number(
+                        origin_str, coordinate_system.origin().value( d ), 0 );
+                }
                 if( dimension == 2 )
                 {
                     absl::StrAppend( &origin_str, " 0" );
                 }
-                header_node.append_attribute( "Origin" )
-                    .set_value( origin_str.c_str() );
+                xml.add_attribute( "Origin", origin_str );
                 std::string spacing_str;
                 for( const auto d : LRange{ dimension } )
                 {
@@ -80,15 +91,14 @@ namespace geode
                     {
                         absl::StrAppend( &spacing_str, " " );
                     }
-                    absl::StrAppend( &spacing_str,
-                        this->mesh().cell_length_in_direction( d ) );
+                    append_number( spacing_str,
+                        this->mesh().cell_length_in_direction( d ), 0 );
                 }
                 if( dimension == 2 )
                 {
                     absl::StrAppend( &spacing_str, " 1" );
                 }
-                header_node.append_attribute( "Spacing" )
-                    .set_value( spacing_str.c_str() );
+                xml.add_attribute( "Spacing", spacing_str );
                 std::string direction_str;
                 for( const auto d1 : LRange{ dimension } )
                 {
@@ -98,7 +108,15 @@ namespace geode
                     }
                     const auto direction =
                         coordinate_system.direction( d1 ).normalize();
-                    absl::StrAppend( &direction_str, direction.string() );
+                    for( const auto d2 : LRange{ dimension } )
+                    {
+                        if( d2 != 0 )
+                        {
+                            direction_str.push_back( ' ' );
+                        }
+                        append_number(
+                            direction_str, direction.value( d2 ), 0 );
+                    }
                     if( dimension == 2 )
                     {
                         absl::StrAppend( &direction_str, " 0" );
@@ -108,22 +126,22 @@ namespace geode
                 {
                     absl::StrAppend( &direction_str, " 0 0 1" );
                 }
-                header_node.append_attribute( "Direction" )
-                    .set_value( direction_str.c_str() );
+                xml.add_attribute( "Direction", direction_str );
             }
 
-            void write_cell_data( pugi::xml_node& piece )
+            void write_cell_data()
             {
-                auto cell_data = piece.append_child( "CellData" );
-                this->write_attributes(
-                    cell_data, this->mesh().cell_attribute_manager() );
+                this->xml().start_element( "CellData" );
+                this->write_attributes( this->mesh().cell_attribute_manager() );
+                this->xml().end_element();
             }
 
-            void write_vertex_data( pugi::xml_node& piece )
+            void write_vertex_data()
             {
-                auto vertex_data = piece.append_child( "PointData" );
+                this->xml().start_element( "PointData" );
                 this->write_attributes(
-                    vertex_data, this->mesh().grid_vertex_attribute_manager() );
+                    this->mesh().grid_vertex_attribute_manager() );
+                this->xml().end_element();
             }
         };
     } // namespace detail
@@ -45,6 +45,12 @@ namespace geode
                 return EXT;
             }
 
+            static std::string_view partitioned_extension()
+            {
+                static constexpr auto EXT = "pvti";
+                return EXT;
+            }
+
             LightRegularGrid< dimension > read() final;
 
             Percentage is_loadable() const final;
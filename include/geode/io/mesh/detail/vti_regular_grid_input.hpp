@@ -44,6 +44,12 @@ namespace geode
                 return EXT;
             }
 
+            static std::string_view partitioned_extension()
+            {
+                static constexpr auto EXT = "pvti";
+                return EXT;
+            }
+
             std::unique_ptr< RegularGrid< dimension > > read(
                 const MeshImpl& impl ) final;
 
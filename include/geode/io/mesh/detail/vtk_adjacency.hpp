@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include <absl/types/span.h>
+
+#include <geode/io/mesh/common.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( SolidMesh );
+    FORWARD_DECLARATION_DIMENSION_CLASS( SolidMeshBuilder );
+    FORWARD_DECLARATION_DIMENSION_CLASS( SurfaceMesh );
+    FORWARD_DECLARATION_DIMENSION_CLASS( SurfaceMeshBuilder );
+    ALIAS_3D( SolidMesh );
+    ALIAS_3D( SolidMeshBuilder );
+} // namespace geode
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * Name of the CellData array storing the adjacencies of the mesh
+         * elements
+         */
+        static constexpr std::string_view VTK_ADJACENCY_ARRAY{
+            "geode_adjacency"
+        };
+
+        /*!
+         * Name of the PointData array storing the mesh vertex of each
+         * vertex of a partitioned file piece
+         */
+        static constexpr std::string_view VTK_GLOBAL_IDS_ARRAY{
+            "geode_global_ids"
+        };
+
+        /*!
+         * Adjacencies of the mesh elements, one tuple per element: the
+         * adjacent element of each element facet (or edge), -1 on borders
+         * and to pad elements with fewer facets than components.
+         */
+        struct VTKAdjacencies
+        {
+            local_index_t nb_components{ 0 };
+            std::vector< int64_t > values;
+        };
+
+        [[nodiscard]] VTKAdjacencies opengeode_io_mesh_api
+            vtk_polyhedron_adjacencies( const SolidMesh3D& solid );
+
+        template < index_t dimension >
+        [[nodiscard]] VTKAdjacencies vtk_polygon_adjacencies(
+            const SurfaceMesh< dimension >& surface );
+
+        /*!
+         * Set the stored adjacencies of the solid polyhedra, if they are
+         * consistent with the solid: each adjacency should refer to an
+         * existing polyhedron, adjacent through a facet made of the same
+         * vertices. The solid is left unchanged otherwise.
+         * @return true if the adjacencies were set.
+         */
+        [[nodiscard]] bool opengeode_io_mesh_api set_vtk_polyhedron_adjacencies(
+            const SolidMesh3D& solid,
+            SolidMeshBuilder3D& builder,
+            absl::Span< const int64_t > adjacencies,
+            index_t nb_components );
+
+        /*!
+         * Set the stored adjacencies of the surface polygons, if they are
+         * consistent with the surface: each adjacency should refer to an
+         * existing polygon, adjacent through an edge made of the same
+         * vertices. The surface is left unchanged otherwise.
+         * @return true if the adjacencies were set.
+         */
+        template < index_t dimension >
+        [[nodiscard]] bool set_vtk_polygon_adjacencies(
+            const SurfaceMesh< dimension >& surface,
+            SurfaceMeshBuilder< dimension >& builder,
+            absl::Span< const int64_t > adjacencies,
+            index_t nb_components );
+    } // namespace detail
+} // namespace geode
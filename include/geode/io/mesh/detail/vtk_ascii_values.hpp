@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <async++.h>
+
+#include <absl/container/fixed_array.h>
+#include <absl/strings/charconv.h>
+#include <absl/types/span.h>
+
+#include <geode/basic/range.hpp>
+
+#include <geode/io/mesh/common.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * Number of text characters above which ASCII values are split into
+         * chunks parsed concurrently
+         */
+        inline constexpr size_t ASCII_VALUES_CHUNK_SIZE = 1 << 20;
+
+        inline bool is_ascii_whitespace( char character )
+        {
+            return character == ' ' || character == '\n' || character == '\t'
+                   || character == '\r' || character == '\v'
+                   || character == '\f';
+        }
+
+        inline const char* skip_ascii_whitespace(
+            const char* first, const char* last )
+        {
+            while( first != last && is_ascii_whitespace( *first ) )
+            {
+                first++;
+            }
+            return first;
+        }
+
+        inline const char* skip_ascii_value(
+            const char* first, const char* last )
+        {
+            while( first != last && !is_ascii_whitespace( *first ) )
+            {
+                first++;
+            }
+            return first;
+        }
+
+        /*!
+         * Split text into chunks of roughly ASCII_VALUES_CHUNK_SIZE
+         * characters, each chunk ending on a whitespace so that no value is
+         * cut.
+         */
+        inline std::vector< std::string_view > split_ascii_values(
+            std::string_view text )
+        {
+            std::vector< std::string_view > chunks;
+            chunks.reserve( text.size() / ASCII_VALUES_CHUNK_SIZE + 1 );
+            const auto* first = text.data();
+            const auto* last = text.data() + text.size();
+            while( first != last )
+            {
+                const auto* chunk_end =
+                    static_cast< size_t >( last - first )
+                            > ASCII_VALUES_CHUNK_SIZE
+                        ? skip_ascii_value(
+                            first + ASCII_VALUES_CHUNK_SIZE, last )
+                        : last;
+                chunks.emplace_back(
+                    first, static_cast< size_t >( chunk_end - first ) );
+                first = chunk_end;
+            }
+            return chunks;
+        }
+
+        inline size_t count_ascii_values( std::string_view text )
+        {
+            size_t nb_values{ 0 };
+            const auto* first = text.data();
+            const auto* last = text.data() + text.size();
+            while( true )
+            {
+                first = skip_ascii_whitespace( first, last );
+                if( first == last )
+                {
+                    return nb_values;
+                }
+                first = skip_ascii_value( first, last );
+                nb_values++;
+            }
+        }
+
+        /*!
+         * Parse whitespace separated values of text into output, which
+         * should be sized to the exact number of values.
+         */
+        template < typename T >
+        void parse_ascii_values( std::string_view text, absl::Span< T > output )
+        {
+            const auto* first = text.data();
+            const auto* last = text.data() + text.size();
+            for( auto& value : output )
+            {
+                first = skip_ascii_whitespace( first, last );
+                OpenGeodeIOMeshException::check_exception( first != last,
+                    nullptr, OpenGeodeException::TYPE::data,
+                    "[VTKInput::read_ascii_values] Not enough values" );
+                const auto* value_end = skip_ascii_value( first, last );
+                const auto* value_start = first;
+                // from_chars rejects the explicit plus sign accepted by
+                // stream extraction
+                if( *value_start == '+' && value_end - value_start > 1
+                    && value_start[1] != '-' && value_start[1] != '+' )
+                {
+                    value_start++;
+                }
+                bool ok;
+                if constexpr( std::is_floating_point_v< T > )
+                {
+                    const auto result =
+                        absl::from_chars( value_start, value_end, value );
+                    ok = result.ec == std::errc{} && result.ptr == value_end;
+                }
+                else
+                {
+                    const auto result =
+                        std::from_chars( value_start, value_end, value );
+                    ok = result.ec == std::errc{} && result.ptr == value_end;
+                }
+                OpenGeodeIOMeshException::check_exception( ok, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTKInput::read_ascii_values] Failed to read value \"",
+                    std::string_view(
+                        first, static_cast< size_t >( value_end - first ) ),
+                    "\"" );
+                first = value_end;
+            }
+            OpenGeodeIOMeshException::check_exception(
+                skip_ascii_whitespace( first, last ) == last, nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTKInput::read_ascii_values] Too many values" );
+        }
+
+        /*!
+         * Read whitespace separated values in a single pass over the text,
+         * without copying it. Large texts are split into whitespace-aligned
+         * chunks parsed concurrently.
+         * @param[in] nb_values Expected number of values, or 0 if unknown.
+         */
+        template < typename T >
+        std::vector< T > read_ascii_values(
+            std::string_view text, size_t nb_values )
+        {
+            if( text.size() <= ASCII_VALUES_CHUNK_SIZE )
+            {
+                if( nb_values == 0 )
+                {
+                    nb_values = count_ascii_values( text );
+                }
+                std::vector< T > values( nb_values );
+                parse_ascii_values< T >( text, absl::MakeSpan( values ) );
+                return values;
+            }
+            const auto chunks = split_ascii_values( text );
+            absl::FixedArray< size_t > chunk_offsets( chunks.size() + 1 );
+            chunk_offsets[0] = 0;
+            async::parallel_for( async::irange( size_t{ 0 }, chunks.size() ),
+                [&chunks, &chunk_offsets]( size_t c ) {
+                    chunk_offsets[c + 1] = count_ascii_values( chunks[c] );
+                } );
+            for( const auto c : Indices{ chunks } )
+            {
+                chunk_offsets[c + 1] += chunk_offsets[c];
+            }
+            OpenGeodeIOMeshException::check_exception(
+                nb_values == 0 || nb_values == chunk_offsets.back(), nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTKInput::read_ascii_values] Wrong number of values: "
+                "should be ",
+                nb_values, ", get ", chunk_offsets.back() );
+            std::vector< T > values( chunk_offsets.back() );
+            async::parallel_for( async::irange( size_t{ 0 }, chunks.size() ),
+                [&chunks, &chunk_offsets, &values]( size_t c ) {
+                    parse_ascii_values< T >( chunks[c],
+                        absl::MakeSpan( values.data() + chunk_offsets[c],
+                            chunk_offsets[c + 1] - chunk_offsets[c] ) );
+                } );
+            return values;
+        }
+    } // namespace detail
+} // namespace geode
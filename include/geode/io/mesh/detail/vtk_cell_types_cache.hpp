@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <geode/io/mesh/common.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        using VTKCellTypes = std::shared_ptr< const std::vector< uint8_t > >;
+
+        /*!
+         * Keep the decoded cell types of a VTK file piece, so that the
+         * several is_loadable calls of the input factory and the following
+         * read decode them only once.
+         * Only the pieces of the last stored file are kept, until
+         * clear_vtk_cell_types is called at the end of the read.
+         * @param[in] encoded_types Types as encoded in the file, identifying
+         * the stored types by their hash.
+         */
+        void opengeode_io_mesh_api store_vtk_cell_types(
+            std::string_view filename,
+            index_t piece,
+            std::string_view encoded_types,
+            VTKCellTypes types );
+
+        /*!
+         * Return the stored cell types of a VTK file piece, or nullptr if
+         * they were not stored or were stored from other encoded types.
+         */
+        [[nodiscard]] VTKCellTypes opengeode_io_mesh_api find_vtk_cell_types(
+            std::string_view filename,
+            index_t piece,
+            std::string_view encoded_types );
+
+        /*!
+         * Drop the stored cell types
+         */
+        void opengeode_io_mesh_api clear_vtk_cell_types();
+    } // namespace detail
+} // namespace geode
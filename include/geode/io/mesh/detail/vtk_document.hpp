@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <pugixml.hpp>
+
+#include <geode/io/mesh/common.hpp>
+#include <geode/io/mesh/detail/mapped_file.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * XML document of a VTK file, parsed in place from its memory mapping.
+         * When the file ends with a raw AppendedData section, only the XML
+         * preceding the binary values is parsed and these values are
+         * accessed in place.
+         * A header document only keeps the XML tags of the file and the
+         * values of the cell "types" DataArray: it is enough to inspect the
+         * file content without parsing (and copying) any other DataArray.
+         */
+        class opengeode_io_mesh_api VTKDocument
+        {
+        public:
+            explicit VTKDocument( std::string_view filename );
+
+            VTKDocument( std::string_view filename, bool header_only );
+
+            const pugi::xml_node& root() const
+            {
+                return root_;
+            }
+
+            bool has_raw_appended_data() const
+            {
+                return has_raw_appended_data_;
+            }
+
+            /*!
+             * Return true if the AppendedData values are accessed in place,
+             * i.e. for a raw AppendedData section or for a header document.
+             */
+            bool has_appended_data() const
+            {
+                return has_appended_data_;
+            }
+
+            /*!
+             * Values of the AppendedData section, starting after the '_'
+             * marker
+             */
+            std::string_view appended_data() const
+            {
+                return appended_data_;
+            }
+
+        private:
+            pugi::xml_parse_result parse();
+
+            pugi::xml_parse_result parse_header();
+
+            void read_appended_data_tag( std::string_view appended_tag,
+                size_t appended_tag_end );
+
+            void check_root( std::string_view filename,
+                const pugi::xml_parse_result& status );
+
+        private:
+            MappedFile file_;
+            std::string xml_header_;
+            pugi::xml_document document_;
+            pugi::xml_node root_;
+            bool has_raw_appended_data_{ false };
+            bool has_appended_data_{ false };
+            std::string_view appended_data_;
+        };
+    } // namespace detail
+} // namespace geode
@@ -25,24 +25,195 @@
 
 #include <geode/io/mesh/common.hpp>
 
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <variant>
 
-#include <pugixml.hpp>
+#include <async++.h>
 
-#include <zlib.h>
+#include <pugixml.hpp>
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <absl/strings/escaping.h>
-#include <absl/strings/str_split.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/match.h>
+#include <absl/strings/str_cat.h>
 
 #include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/filename.hpp>
+#include <geode/basic/string.hpp>
 #include <geode/basic/variable_attribute.hpp>
 
 #include <geode/geometry/point.hpp>
 
+#include <geode/io/image/detail/base64.hpp>
+#include <geode/io/image/detail/vtk_compressor.hpp>
+
+#include <geode/io/mesh/detail/vtk_ascii_values.hpp>
+#include <geode/io/mesh/detail/vtk_document.hpp>
+#include <geode/io/mesh/vtk_input_options.hpp>
+
 namespace geode
 {
     namespace detail
     {
+        /*!
+         * Sequential reader of binary values encoded in base64.
+         * Consecutive reads may split base64 groups: the bytes decoded
+         * beyond a read are kept for the next one. Whitespace inside the
+         * encoded values (e.g. wrapped lines) is skipped.
+         */
+        class VTKBase64Stream
+        {
+        public:
+            explicit VTKBase64Stream( std::string_view input )
+                : input_{ input }
+            {
+            }
+
+            void read( absl::Span< char > output )
+            {
+                const auto nb_buffered_bytes = std::min(
+                    output.size(), buffer_size_ - buffer_position_ );
+                std::memcpy( output.data(), buffer_.data() + buffer_position_,
+                    nb_buffered_bytes );
+                buffer_position_ += nb_buffered_bytes;
+                output.remove_prefix( nb_buffered_bytes );
+                const auto nb_groups = output.size() / 3;
+                decode_exactly( next_characters( 4 * nb_groups ),
+                    output.subspan( 0, 3 * nb_groups ) );
+                output.remove_prefix( 3 * nb_groups );
+                if( output.empty() )
+                {
+                    return;
+                }
+                buffer_size_ = decode_base64(
+                    next_characters( 4 ), absl::MakeSpan( buffer_ ) );
+                OpenGeodeIOMeshException::check_exception(
+                    buffer_size_ >= output.size(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTKInput::decode] Base64 data is truncated" );
+                std::memcpy( output.data(), buffer_.data(), output.size() );
+                buffer_position_ = output.size();
+            }
+
+            std::string_view read_view( size_t nb_bytes )
+            {
+                storage_.resize( nb_bytes );
+                read( absl::MakeSpan( storage_ ) );
+                return { storage_.data(), nb_bytes };
+            }
+
+            /*!
+             * Discard the padded end of the current base64 stream: the next
+             * read starts a new stream.
+             */
+            void end_stream()
+            {
+                buffer_position_ = buffer_size_;
+            }
+
+        private:
+            /*!
+             * Next characters containing the given number of base64
+             * characters, whitespace being included but not counted
+             */
+            std::string_view next_characters( size_t nb_characters )
+            {
+                const auto start = position_;
+                auto nb_missing = nb_characters;
+                while( nb_missing > 0 && position_ < input_.size() )
+                {
+                    const auto end =
+                        std::min( position_ + nb_missing, input_.size() );
+                    nb_missing -= end - position_;
+                    for( ; position_ < end; position_++ )
+                    {
+                        if( absl::ascii_isspace(
+                                static_cast< unsigned char >(
+                                    input_[position_] ) ) )
+                        {
+                            nb_missing++;
+                        }
+                    }
+                }
+                return input_.substr( start, position_ - start );
+            }
+
+            static void decode_exactly(
+                std::string_view input, absl::Span< char > output )
+            {
+                const auto nb_decoded_bytes = decode_base64( input, output );
+                OpenGeodeIOMeshException::check_exception(
+                    nb_decoded_bytes == output.size(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTKInput::decode] Base64 data is truncated (expected ",
+                    output.size(), " bytes, got ", nb_decoded_bytes, ")" );
+            }
+
+        private:
+            std::string_view input_;
+            size_t position_{ 0 };
+            std::array< char, 3 > buffer_;
+            size_t buffer_size_{ 0 };
+            size_t buffer_position_{ 0 };
+            std::vector< char > storage_;
+        };
+
+        /*!
+         * Sequential reader of raw binary values, read in place.
+         */
+        class VTKRawStream
+        {
+        public:
+            explicit VTKRawStream( std::string_view input ) : input_{ input }
+            {
+            }
+
+            void read( absl::Span< char > output )
+            {
+                const auto bytes = read_view( output.size() );
+                std::memcpy( output.data(), bytes.data(), bytes.size() );
+            }
+
+            std::string_view read_view( size_t nb_bytes )
+            {
+                OpenGeodeIOMeshException::check_exception(
+                    nb_bytes <= input_.size() - position_, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTKInput::decode] Raw data is truncated" );
+                const auto bytes = input_.substr( position_, nb_bytes );
+                position_ += nb_bytes;
+                return bytes;
+            }
+
+            void end_stream() {}
+
+        private:
+            std::string_view input_;
+            size_t position_{ 0 };
+        };
+
+        /*!
+         * Values of a PointData or CellData array, decoded but not yet
+         * stored as an attribute
+         */
+        struct VTKDataArrayValues
+        {
+            std::string_view name;
+            index_t nb_components{ 1 };
+            std::variant< std::monostate,
+                std::vector< double >,
+                std::vector< index_t >,
+                std::vector< long int > >
+                values;
+        };
+
         template < typename Mesh >
         class VTKInputImpl
         {
@@ -51,7 +222,15 @@ namespace geode
 
             std::unique_ptr< Mesh > read_file()
             {
+                load_document( false );
+                if( is_partitioned_file() )
+                {
+                    read_partitioned_file(
+                        root_.child( partitioned_type_.c_str() ) );
+                    return std::move( mesh_ );
+                }
                 read_common_data();
+                set_attribute_value_types( piece_nodes() );
                 for( const auto& vtk_object : root_.children( type_ ) )
                 {
                     read_vtk_object( vtk_object );
@@ -61,6 +240,11 @@ namespace geode
 
             Percentage is_loadable()
             {
+                load_document( true );
+                if( is_partitioned_file() )
+                {
+                    return is_partitioned_file_loadable();
+                }
                 read_common_data();
                 std::vector< Percentage > percentages;
                 for( const auto& vtk_object : root_.children( type_ ) )
@@ -81,24 +265,92 @@ namespace geode
             }
 
         protected:
+            using PieceReader = std::unique_ptr< VTKInputImpl >;
+
             VTKInputImpl( std::string_view filename, const char* type )
-                : file_{ to_string( filename ) }, type_{ type }
+                : filename_{ filename },
+                  type_{ type },
+                  partitioned_type_{ absl::StrCat( "P", type ) },
+                  options_{ vtk_input_options() }
             {
-                OpenGeodeIOMeshException::check_exception( file_.good(),
-                    nullptr, OpenGeodeException::TYPE::data,
-                    "[VTKInput] Error while opening file: ", filename );
-                const auto status =
-                    document_.load_file( to_string( filename ).c_str() );
-                OpenGeodeIOMeshException::check_exception( status, nullptr,
-                    OpenGeodeException::TYPE::internal, status.description(),
-                    "[VTKInput] Error while parsing file: ", filename );
-                root_ = document_.child( "VTKFile" );
             }
 
             virtual void is_vtk_object_loadable(
                 const pugi::xml_node& vtk_object,
                 std::vector< Percentage >& percentages ) const = 0;
 
+            /*!
+             * Create a reader of the same kind for a piece file of a
+             * partitioned file (.pvtu, .pvtp, .pvti)
+             */
+            virtual PieceReader create_piece_reader(
+                std::string_view filename ) const = 0;
+
+            /*!
+             * Read the piece files referenced by the given partitioned
+             * object (PUnstructuredGrid, PPolyData, PImageData) into the
+             * mesh
+             */
+            virtual void read_partitioned_file(
+                const pugi::xml_node& partitioned_object ) = 0;
+
+            /*!
+             * Create and fully load a reader per piece file of the
+             * partitioned file, concurrently. Attribute value types are
+             * chosen across the pieces of every reader.
+             */
+            std::vector< PieceReader > open_piece_readers() const
+            {
+                const auto sources = piece_sources();
+                std::vector< PieceReader > readers( sources.size() );
+                async::parallel_for(
+                    async::irange( size_t{ 0 }, sources.size() ),
+                    [&readers, &sources, this]( size_t s ) {
+                        auto reader = create_piece_reader( sources[s] );
+                        reader->load_document( false );
+                        OpenGeodeIOMeshException::check_exception(
+                            !reader->is_partitioned_file(), nullptr,
+                            OpenGeodeException::TYPE::data,
+                            "[VTKInput::open_piece_readers] Piece file ",
+                            sources[s], " should not be partitioned" );
+                        reader->read_common_data();
+                        readers[s] = std::move( reader );
+                    } );
+                std::vector< pugi::xml_node > pieces;
+                for( const auto& reader : readers )
+                {
+                    const auto reader_pieces = reader->piece_nodes();
+                    pieces.insert( pieces.end(), reader_pieces.begin(),
+                        reader_pieces.end() );
+                }
+                for( auto& reader : readers )
+                {
+                    reader->set_attribute_value_types( pieces );
+                }
+                return readers;
+            }
+
+            /*!
+             * Piece nodes of every VTK object of the file, in file order
+             */
+            std::vector< pugi::xml_node > piece_nodes() const
+            {
+                std::vector< pugi::xml_node > pieces;
+                for( const auto& vtk_object : root_.children( type_ ) )
+                {
+                    for( const auto& piece : vtk_object.children( "Piece" ) )
+                    {
+                        pieces.push_back( piece );
+                    }
+                }
+                return pieces;
+            }
+
+            std::string_view filename() const
+            {
+                return filename_;
+            }
+
             void read_common_data()
             {
                 read_root_attributes();
@@ -128,203 +380,222 @@ namespace geode
                     piece.attribute( attribute.data() ).value() );
             }
 
-            template < typename T >
-            std::vector< T > read_integer_data_array(
+            /*!
+             * Read the values of a DataArray as Target values, whatever the
+             * VTK type of the array: values are converted while being
+             * decoded, without any intermediate array.
+             */
+            template < typename Target >
+            std::vector< Target > read_data_array(
                 const pugi::xml_node& data ) const
             {
-                const auto format = data.attribute( "format" ).value();
-                if( match( format, "appended" ) )
+                const auto type = data.attribute( "type" ).value();
+                if( match( type, "Float64" ) )
                 {
-                    return decode< T >( read_appended_data( data ) );
+                    return read_typed_data_array< double, Target >( data );
                 }
-                else
+                if( match( type, "Float32" ) )
                 {
-                    const auto data_string =
-                        absl::StripAsciiWhitespace( data.child_value() );
-                    if( match( format, "ascii" ) )
-                    {
-                        auto string = to_string( data_string );
-                        absl::RemoveExtraAsciiWhitespace( &string );
-                        return read_ascii_integer_data_array< T >( string );
-                    }
-                    return decode< T >( data_string );
+                    return read_typed_data_array< float, Target >( data );
                 }
-            }
-
-            template < typename T >
-            std::vector< T > read_uint8_data_array(
-                const pugi::xml_node& data ) const
-            {
-                const auto format = data.attribute( "format" ).value();
-                if( match( format, "appended" ) )
+                if( match( type, "Int64" ) )
                 {
-                    return decode< T >( read_appended_data( data ) );
+                    return read_typed_data_array< int64_t, Target >( data );
                 }
-                else
+                if( match( type, "UInt64" ) )
                 {
-                    const auto data_string =
-                        absl::StripAsciiWhitespace( data.child_value() );
-                    if( match( format, "ascii" ) )
-                    {
-                        auto string = to_string( data_string );
-                        absl::RemoveExtraAsciiWhitespace( &string );
-                        return read_ascii_uint8_data_array< T >( string );
-                    }
-                    return decode< T >( data_string );
+                    return read_typed_data_array< uint64_t, Target >( data );
                 }
-            }
-
-            template < typename T >
-            std::vector< T > read_float_data_array(
-                const pugi::xml_node& data ) const
-            {
-                const auto format = data.attribute( "format" ).value();
-                if( match( format, "appended" ) )
+                if( match( type, "Int32" ) )
                 {
-                    return decode< T >( read_appended_data( data ) );
+                    return read_typed_data_array< int32_t, Target >( data );
                 }
-                else
+                if( match( type, "UInt32" ) )
                 {
-                    const auto data_string =
-                        absl::StripAsciiWhitespace( data.child_value() );
-                    if( match( format, "ascii" ) )
-                    {
-                        auto string = to_string( data_string );
-                        absl::RemoveExtraAsciiWhitespace( &string );
-                        return read_ascii_float_data_array< T >( string );
-                    }
-                    return decode< T >( data_string );
+                    return read_typed_data_array< uint32_t, Target >( data );
+                }
+                if( match( type, "Int16" ) )
+                {
+                    return read_typed_data_array< int16_t, Target >( data );
+                }
+                if( match( type, "UInt16" ) )
+                {
+                    return read_typed_data_array< uint16_t, Target >( data );
+                }
+                if( match( type, "Int8" ) )
+                {
+                    return read_typed_data_array< int8_t, Target >( data );
+                }
+                if( match( type, "UInt8" ) )
+                {
+                    return read_typed_data_array< uint8_t, Target >( data );
                 }
+                throw OpenGeodeIOMeshException{ nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTKInput::read_data_array] DataArray of type ", type,
+                    " is not supported" };
             }
 
-            template < typename Out, typename In >
-            std::vector< Out > cast_to( absl::Span< const In > values )
+            size_t expected_nb_values( const pugi::xml_node& data ) const
             {
-                std::vector< Out > result( values.size() );
-                for( const auto v : Indices{ values } )
-                {
-                    result[v] = static_cast< Out >( values[v] );
-                }
-                return result;
+                return data.attribute( "NumberOfTuples" ).as_ullong()
+                       * data.attribute( "NumberOfComponents" ).as_ullong( 1 );
             }
 
-            template < typename T >
+            template < typename T, typename ElementIndex >
             void build_attribute( AttributeManager& manager,
                 std::string_view name,
                 absl::Span< const T > values,
                 index_t nb_components,
-                index_t offset )
+                const ElementIndex& element_index )
             {
                 OpenGeodeIOMeshException::check_exception(
                     values.size() % nb_components == 0, nullptr,
                     OpenGeodeException::TYPE::data,
                     "[VTKInput::build_attribute] Number of attribute "
                     "values is not a multiple of number of components" );
-                if( manager.find_generic_attribute( name ) )
+                // Existing attributes are kept, except the ones created by
+                // the previous pieces of the file which are completed
+                const auto key = std::make_pair( &manager, to_string( name ) );
+                if( !created_attributes_.contains( key )
+                    && manager.find_generic_attribute( name ) )
                 {
                     return;
                 }
+                created_attributes_.emplace( key );
                 if( nb_components == 1 )
                 {
                     auto attribute =
                         manager
                             .find_or_create_attribute< VariableAttribute, T >(
                                 name, T{} );
+                    // VariableAttribute is not thread-safe: values are
+                    // written sequentially
                     for( const auto i : Indices{ values } )
                     {
-                        attribute->set_value( i + offset, values[i] );
+                        attribute->set_value(
+                            element_index( static_cast< index_t >( i ) ),
+                            values[i] );
                     }
                 }
                 else if( nb_components == 2 )
                 {
-                    create_attribute< std::array< T, 2 >, T >(
-                        manager, {}, values, nb_components, name, offset );
+                    create_attribute< std::array< T, 2 >, T >( manager, {},
+                        values, nb_components, name, element_index );
                 }
                 else if( nb_components == 3 )
                 {
-                    create_attribute< std::array< T, 3 >, T >(
-                        manager, {}, values, nb_components, name, offset );
+                    create_attribute< std::array< T, 3 >, T >( manager, {},
+                        values, nb_components, name, element_index );
                 }
                 else
                 {
                     create_attribute< std::vector< T >, T >( manager,
                         std::vector< T >( nb_components ), values,
-                        nb_components, name, offset );
+                        nb_components, name, element_index );
                 }
             }
 
-            void read_attribute_data( const pugi::xml_node& data,
-                index_t offset,
-                AttributeManager& attribute_manager )
+            VTKDataArrayValues decode_attribute_data(
+                const pugi::xml_node& data ) const
             {
-                const auto data_array_name = data.attribute( "Name" ).value();
+                VTKDataArrayValues array;
+                array.name = data.attribute( "Name" ).value();
                 const auto data_array_type = data.attribute( "type" ).value();
-                index_t nb_components{ 1 };
                 if( const auto data_nb_components =
                         data.attribute( "NumberOfComponents" ) )
                 {
-                    nb_components =
+                    array.nb_components =
                         read_attribute( data, "NumberOfComponents" );
                 }
-                if( match( data_array_type, "Float64" )
-                    || match( data_array_type, "Float32" ) )
+                const auto value_type = attribute_value_type( data );
+                OpenGeodeIOMeshException::check_exception(
+                    value_type.has_value(), nullptr,
+                    OpenGeodeException::TYPE::internal,
+                    "[VTKInput::read_data] Attribute of type ",
+                    data_array_type, " is not supported" );
+                if( value_type == ATTRIBUTE_VALUE_TYPE::floating )
                 {
-                    const auto attribute_values =
-                        read_float_data_array< double >( data );
-                    build_attribute< double >( attribute_manager,
-                        data_array_name, attribute_values, nb_components,
-                        offset );
+                    array.values = read_data_array< double >( data );
                 }
-                else if( match( data_array_type, "Int64" )
-                         || match( data_array_type, "UInt32" )
-                         || match( data_array_type, "Int32" )
-                         || match( data_array_type, "UInt64" ) )
+                else if( value_type == ATTRIBUTE_VALUE_TYPE::signed_integer )
                 {
-                    const auto min_value = read_attribute( data, "RangeMin" );
-                    const auto max_value = read_attribute( data, "RangeMax" );
-                    if( min_value >= 0
-                        && max_value < std::numeric_limits< index_t >::max() )
-                    {
-                        const auto attribute_values =
-                            read_integer_data_array< index_t >( data );
-                        build_attribute< index_t >( attribute_manager,
-                            data_array_name, attribute_values, nb_components,
-                            offset );
-                    }
-                    else
-                    {
-                        const auto attribute_values =
-                            read_integer_data_array< long int >( data );
-                        build_attribute< long int >( attribute_manager,
-                            data_array_name, attribute_values, nb_components,
-                            offset );
-                    }
+                    array.values = read_data_array< long int >( data );
                 }
-                else if( match( data_array_type, "Int8" ) )
+                else
                 {
-                    // const auto attribute_values =
-                    //     read_uint8_data_array< int8_t >( data );
-                    // const auto attribute_values_as_int =
-                    //     cast_to< int >( attribute_values );
-                    // build_attribute( attribute_manager, data_array_name,
-                    //     attribute_values_as_int, nb_components, offset );
+                    array.values = read_data_array< index_t >( data );
                 }
-                else if( match( data_array_type, "UInt8" ) )
+                return array;
+            }
+
+            /*!
+             * Decode the PointData or CellData arrays, concurrently. Arrays
+             * rejected by the attribute filter are skipped.
+             */
+            std::vector< VTKDataArrayValues > decode_data(
+                const pugi::xml_node& point_data ) const
+            {
+                const auto& filter = options_.attribute_filter;
+                std::vector< pugi::xml_node > data_arrays;
+                for( const auto& data : point_data.children( "DataArray" ) )
                 {
-                    const auto attribute_values =
-                        read_uint8_data_array< uint8_t >( data );
-                    const auto attribute_values_as_int =
-                        cast_to< index_t, uint8_t >( attribute_values );
-                    build_attribute< index_t >( attribute_manager,
-                        data_array_name, attribute_values_as_int, nb_components,
-                        offset );
+                    if( ( filter
+                            && !filter( data.attribute( "Name" ).value() ) )
+                        || skip_data_array( data ) )
+                    {
+                        continue;
+                    }
+                    data_arrays.push_back( data );
                 }
-                else
+                std::vector< VTKDataArrayValues > arrays( data_arrays.size() );
+                async::parallel_for(
+                    async::irange( size_t{ 0 }, data_arrays.size() ),
+                    [&arrays, &data_arrays, this]( size_t a ) {
+                        arrays[a] = decode_attribute_data( data_arrays[a] );
+                    } );
+                return arrays;
+            }
+
+            /*!
+             * Store decoded arrays as attributes, in file order
+             */
+            void store_data( absl::Span< const VTKDataArrayValues > arrays,
+                index_t offset,
+                AttributeManager& attribute_manager )
+            {
+                store_data(
+                    arrays,
+                    [offset]( index_t e ) {
+                        return e + offset;
+                    },
+                    attribute_manager );
+            }
+
+            /*!
+             * Store decoded arrays as attributes, the value of the array
+             * element e being stored on element element_index( e )
+             */
+            template < typename ElementIndex >
+            void store_data( absl::Span< const VTKDataArrayValues > arrays,
+                const ElementIndex& element_index,
+                AttributeManager& attribute_manager )
+            {
+                for( const auto& array : arrays )
                 {
-                    throw OpenGeodeIOMeshException{ nullptr,
-                        OpenGeodeException::TYPE::internal,
-                        "[VTKInput::read_data] Attribute of type ",
-                        data_array_type, " is not supported" };
+                    std::visit(
+                        [&]( const auto& values ) {
+                            using Values = std::decay_t< decltype( values ) >;
+                            if constexpr( !std::is_same_v< Values,
+                                              std::monostate > )
+                            {
+                                build_attribute<
+                                    typename Values::value_type >(
+                                    attribute_manager, array.name, values,
+                                    array.nb_components, element_index );
+                            }
+                        },
+                        array.values );
                 }
             }
 
@@ -332,61 +603,256 @@ namespace geode
                 index_t offset,
                 AttributeManager& attribute_manager )
             {
-                for( const auto& data : point_data.children( "DataArray" ) )
+                store_data( decode_data( point_data ), offset,
+                    attribute_manager );
+            }
+
+            const VTKInputOptions& options() const
+            {
+                return options_;
+            }
+
+            bool has_raw_appended_data() const
+            {
+                return document_ && document_->has_raw_appended_data();
+            }
+
+            /*!
+             * Return true if the PointData or CellData array should be
+             * neither decoded nor created as an attribute
+             */
+            virtual bool skip_data_array(
+                const pugi::xml_node& /*unused*/ ) const
+            {
+                return false;
+            }
+
+            template < typename Source, typename Target = Source >
+            std::vector< Target > decode_appended(
+                const pugi::xml_node& data ) const
+            {
+                const auto offset = data.attribute( "offset" ).as_ullong();
+                OpenGeodeIOMeshException::check_exception(
+                    offset <= appended_data_.size(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTKInput::decode_appended] DataArray offset is out of "
+                    "AppendedData section" );
+                const auto input = appended_data_.substr( offset );
+                if( document_->has_raw_appended_data() )
+                {
+                    VTKRawStream stream{ input };
+                    return decode_stream< Source, Target >( stream );
+                }
+                VTKBase64Stream stream{ input };
+                return decode_stream< Source, Target >( stream );
+            }
+
+            template < typename Source, typename Target = Source >
+            std::vector< Target > decode( std::string_view input ) const
+            {
+                VTKBase64Stream stream{ input };
+                return decode_stream< Source, Target >( stream );
+            }
+
+            /*!
+             * Values of the DataArray as they are encoded in the file, header
+             * included, without decoding them
+             */
+            std::string_view encoded_values( const pugi::xml_node& data ) const
+            {
+                if( !match( data.attribute( "format" ).value(), "appended" ) )
                 {
-                    read_attribute_data( data, offset, attribute_manager );
+                    return data.child_value();
                 }
+                const auto offset = data.attribute( "offset" ).as_ullong();
+                OpenGeodeIOMeshException::check_exception(
+                    offset <= appended_data_.size(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTKInput::encoded_values] DataArray offset is out of "
+                    "AppendedData section" );
+                const auto input = appended_data_.substr( offset );
+                if( document_->has_raw_appended_data() )
+                {
+                    VTKRawStream stream{ input };
+                    const auto sizes = encoded_sizes( stream );
+                    return input.substr( 0, sizes.first + sizes.second );
+                }
+                VTKBase64Stream stream{ input };
+                const auto sizes = encoded_sizes( stream );
+                // Header and values are encoded either together or as two
+                // base64 streams: two streams are an upper bound
+                const auto nb_characters =
+                    base64_encoded_size( sizes.first )
+                    + base64_encoded_size( sizes.second );
+                return input.substr( 0, nb_characters );
             }
 
-            std::string_view read_appended_data(
+        private:
+            /*!
+             * Value types of the attributes read from a DataArray, ordered
+             * so that the greatest type holds the values of the others
+             */
+            enum struct ATTRIBUTE_VALUE_TYPE
+            {
+                index,
+                signed_integer,
+                floating
+            };
+
+            /*!
+             * Value type of the attribute read from a single DataArray.
+             * Unsigned values are read as index_t when they fit, signed
+             * values and values of unknown range as long int.
+             */
+            std::optional< ATTRIBUTE_VALUE_TYPE > data_array_value_type(
                 const pugi::xml_node& data ) const
             {
-                const auto offset = data.attribute( "offset" ).as_uint();
-                return appended_data_.substr( offset );
+                const auto type = data.attribute( "type" ).value();
+                if( match( type, "Float64" ) || match( type, "Float32" ) )
+                {
+                    return ATTRIBUTE_VALUE_TYPE::floating;
+                }
+                if( match( type, "UInt32" ) || match( type, "UInt16" )
+                    || match( type, "UInt8" ) )
+                {
+                    return ATTRIBUTE_VALUE_TYPE::index;
+                }
+                if( match( type, "UInt64" ) )
+                {
+                    const auto max_value = data.attribute( "RangeMax" );
+                    if( max_value
+                        && max_value.as_ullong()
+                               < std::numeric_limits< index_t >::max() )
+                    {
+                        return ATTRIBUTE_VALUE_TYPE::index;
+                    }
+                    return ATTRIBUTE_VALUE_TYPE::signed_integer;
+                }
+                if( match( type, "Int64" ) || match( type, "Int32" )
+                    || match( type, "Int16" ) || match( type, "Int8" ) )
+                {
+                    return ATTRIBUTE_VALUE_TYPE::signed_integer;
+                }
+                return std::nullopt;
             }
 
-            template < typename T >
-            std::vector< T > decode( std::string_view input ) const
+            /*!
+             * Choose the value type of each PointData and CellData
+             * attribute once across the given pieces, so that every piece
+             * reads the values of an attribute with the same type
+             */
+            void set_attribute_value_types(
+                absl::Span< const pugi::xml_node > pieces )
             {
-                if( !compressed_ )
+                attribute_value_types_.clear();
+                for( const auto& piece : pieces )
                 {
-                    if( is_uint64_ )
+                    for( const auto* section : { "PointData", "CellData" } )
                     {
-                        return templated_decode_uncompressed< T, uint64_t >(
-                            input );
+                        for( const auto& data :
+                            piece.child( section ).children( "DataArray" ) )
+                        {
+                            const auto value_type =
+                                data_array_value_type( data );
+                            if( !value_type )
+                            {
+                                continue;
+                            }
+                            const auto it = attribute_value_types_.try_emplace(
+                                std::make_pair( std::string{ section },
+                                    std::string{
+                                        data.attribute( "Name" ).value() } ),
+                                value_type.value() );
+                            it.first->second = std::max(
+                                it.first->second, value_type.value() );
+                        }
                     }
-                    return templated_decode_uncompressed< T, uint32_t >(
-                        input );
                 }
-                if( is_uint64_ )
+            }
+
+            std::optional< ATTRIBUTE_VALUE_TYPE > attribute_value_type(
+                const pugi::xml_node& data ) const
+            {
+                const auto it = attribute_value_types_.find(
+                    std::make_pair( std::string{ data.parent().name() },
+                        std::string{ data.attribute( "Name" ).value() } ) );
+                if( it != attribute_value_types_.end() )
                 {
-                    return templated_decode< T, uint64_t >( input );
+                    return it->second;
                 }
-                return templated_decode< T, uint32_t >( input );
+                return data_array_value_type( data );
             }
 
-        private:
-            template < typename Container, typename T >
+            template < typename Source, typename Target >
+            std::vector< Target > read_typed_data_array(
+                const pugi::xml_node& data ) const
+            {
+                const auto format = data.attribute( "format" ).value();
+                if( match( format, "appended" ) )
+                {
+                    return decode_appended< Source, Target >( data );
+                }
+                if( match( format, "ascii" ) )
+                {
+                    const auto text = data.child_value();
+                    const auto nb_values = expected_nb_values( data );
+                    if constexpr( std::is_floating_point_v< Source >
+                                  == std::is_floating_point_v< Target > )
+                    {
+                        return read_ascii_values< Target >( text, nb_values );
+                    }
+                    else
+                    {
+                        const auto values =
+                            read_ascii_values< Source >( text, nb_values );
+                        std::vector< Target > result( values.size() );
+                        convert_values< Source, Target >(
+                            values, result.data() );
+                        return result;
+                    }
+                }
+                return decode< Source, Target >(
+                    absl::StripAsciiWhitespace( data.child_value() ) );
+            }
+
+            template < typename Source, typename Target >
+            static void convert_values(
+                absl::Span< const Source > values, Target* output )
+            {
+                for( const auto v : Indices{ values } )
+                {
+                    output[v] = static_cast< Target >( values[v] );
+                }
+            }
+
+            template < typename Container,
+                typename T,
+                typename ElementIndex >
             void create_attribute( AttributeManager& manager,
                 const Container& default_value,
                 absl::Span< const T > values,
                 index_t nb_components,
                 std::string_view name,
-                index_t offset )
+                const ElementIndex& element_index )
             {
                 auto attribute =
                     manager.find_or_create_attribute< VariableAttribute,
                         Container >( name, default_value );
-                for( const auto i : Range{ values.size() / nb_components } )
+                // Components are written in place, without intermediate
+                // copies, and sequentially as VariableAttribute is not
+                // thread-safe
+                const auto nb_elements =
+                    static_cast< index_t >( values.size() / nb_components );
+                for( const auto e : Range{ nb_elements } )
                 {
-                    for( const auto c : Range{ nb_components } )
-                    {
-                        const auto& new_value = values[nb_components * i + c];
-                        attribute->modify_value(
-                            i + offset, [&new_value, &c]( Container& value ) {
-                                value[c] = new_value;
-                            } );
-                    }
+                    const auto* components = values.data() + nb_components * e;
+                    attribute->modify_value( element_index( e ),
+                        [components, nb_components]( Container& value ) {
+                            for( const auto c : Range{ nb_components } )
+                            {
+                                value[c] = components[c];
+                            }
+                        } );
                 }
             }
 
@@ -403,14 +869,8 @@ namespace geode
                     nullptr, OpenGeodeException::TYPE::internal,
                     "[VTKInput::read_root_attributes] Big Endian not "
                     "supported" );
-                const auto compressor = root_.attribute( "compressor" ).value();
-                OpenGeodeIOMeshException::check_exception(
-                    std::string_view( compressor ).empty()
-                        || match( compressor, "vtkZLibDataCompressor" ),
-                    nullptr, OpenGeodeException::TYPE::internal,
-                    "[VTKInput::read_root_attributes] Only "
-                    "vtkZLibDataCompressor is supported for now" );
-                compressed_ = !std::string_view( compressor ).empty();
+                compressor_ = VTKCompressor::from_vtk_name(
+                    root_.attribute( "compressor" ).value() );
 
                 if( const auto header_type = root_.attribute( "header_type" ) )
                 {
@@ -434,11 +894,16 @@ namespace geode
                 {
                     return;
                 }
+                if( document_->has_appended_data() )
+                {
+                    appended_data_ = document_->appended_data();
+                    return;
+                }
                 OpenGeodeIOMeshException::check_exception(
                     match( node.attribute( "encoding" ).value(), "base64" ),
                     nullptr, OpenGeodeException::TYPE::data,
                     "[VTKInput::read_appended_data] VTK AppendedData "
-                    "section should be encoded" );
+                    "section should be raw or base64 encoded" );
                 appended_data_ = node.child_value();
                 appended_data_ = absl::StripAsciiWhitespace( appended_data_ );
                 appended_data_.remove_prefix( 1 ); // skip first char: '_'
@@ -447,196 +912,273 @@ namespace geode
             virtual void read_vtk_object(
                 const pugi::xml_node& vtk_object ) = 0;
 
-            template < typename T, typename UInt >
-            std::vector< T > templated_decode_uncompressed(
-                std::string_view input ) const
-            {
-                const auto nb_chars = nb_char_needed< UInt >( 1 );
-                const auto nb_bytes_input = input.substr( 0, nb_chars );
-                const auto decoded_nb_bytes_input =
-                    decode_base64( nb_bytes_input );
-                const auto nb_data = *reinterpret_cast< const UInt* >(
-                                         decoded_nb_bytes_input.c_str() )
-                                     / sizeof( T );
-                const auto nb_chars2 = nb_char_needed< T >( nb_data );
-
-                const auto data = input.substr( 0, nb_chars + nb_chars2 );
-                const auto decoded_data = decode_base64( data );
-                const auto values = reinterpret_cast< const T* >(
-                    decoded_data.c_str() + sizeof( UInt ) );
-                // skip first UInt that gives the number of bytes
-                const auto nb_values =
-                    ( decoded_data.size() - sizeof( UInt ) ) / sizeof( T );
-                std::vector< T > result( nb_values );
-                for( const auto v : Range{ nb_values } )
-                {
-                    result[v] = values[v];
+            bool is_partitioned_file() const
+            {
+                return match(
+                    root_.attribute( "type" ).value(), partitioned_type_ );
+            }
+
+            /*!
+             * Paths of the piece files, relative paths being given from the
+             * directory of the partitioned file
+             */
+            std::vector< std::string > piece_sources() const
+            {
+                const auto directory = filepath_without_filename( filename_ );
+                std::vector< std::string > sources;
+                for( const auto& piece :
+                    root_.child( partitioned_type_.c_str() )
+                        .children( "Piece" ) )
+                {
+                    const std::string_view source =
+                        piece.attribute( "Source" ).value();
+                    OpenGeodeIOMeshException::check_exception( !source.empty(),
+                        nullptr, OpenGeodeException::TYPE::data,
+                        "[VTKInput::piece_sources] Piece without Source in "
+                        "file ",
+                        filename_ );
+                    sources.push_back( ( directory / source ).string() );
                 }
-                return result;
+                return sources;
+            }
+
+            Percentage is_partitioned_file_loadable() const
+            {
+                const auto sources = piece_sources();
+                if( sources.empty() )
+                {
+                    return Percentage{ 0 };
+                }
+                double value{ 0 };
+                for( const auto& source : sources )
+                {
+                    value += create_piece_reader( source )
+                                 ->is_loadable()
+                                 .value();
+                }
+                return Percentage{ value / sources.size() };
+            }
+
+            void load_document( bool header_only )
+            {
+                // Loadability only needs the file header: DataArray values
+                // are left unparsed, except the cell types
+                document_.emplace( filename_, header_only );
+                root_ = document_->root();
+            }
+
+            template < typename Source, typename Target, typename Stream >
+            std::vector< Target > decode_stream( Stream& stream ) const
+            {
+                if( !compressor_.is_compressed() )
+                {
+                    if( is_uint64_ )
+                    {
+                        return templated_decode_uncompressed< Source, Target,
+                            uint64_t >( stream );
+                    }
+                    return templated_decode_uncompressed< Source, Target,
+                        uint32_t >( stream );
+                }
+                if( is_uint64_ )
+                {
+                    return templated_decode< Source, Target, uint64_t >(
+                        stream );
+                }
+                return templated_decode< Source, Target, uint32_t >( stream );
             }
 
-            template < typename UInt, typename UInt2 >
-            constexpr index_t nb_char_needed( UInt2 nb_values ) const
+            template < typename Source,
+                typename Target,
+                typename UInt,
+                typename Stream >
+            std::vector< Target > templated_decode_uncompressed(
+                Stream& stream ) const
             {
-                // to encode the nb values in base64
-                // ((nb * 8 * nb bytes) bits / 6) ->ceil
-                return static_cast< index_t >(
-                    4
-                    * std::ceil(
-                        nb_values * 8. * sizeof( UInt ) / ( 6. * 4. ) ) );
+                UInt nb_bytes;
+                stream.read( value_bytes( nb_bytes ) );
+                check_nb_bytes< Source >( nb_bytes );
+                std::vector< Target > result( nb_bytes / sizeof( Source ) );
+                if constexpr( std::is_same_v< Source, Target > )
+                {
+                    stream.read( to_bytes( result ) );
+                }
+                else
+                {
+                    // Values are converted chunk by chunk while being read
+                    std::array< Source, CONVERSION_CHUNK_SIZE > chunk;
+                    for( size_t start = 0; start < result.size();
+                         start += chunk.size() )
+                    {
+                        const auto nb_values =
+                            std::min( chunk.size(), result.size() - start );
+                        const auto values =
+                            absl::MakeSpan( chunk ).subspan( 0, nb_values );
+                        stream.read( to_bytes( values ) );
+                        convert_values< Source, Target >(
+                            values, result.data() + start );
+                    }
+                }
+                return result;
             }
 
-            template < typename T, typename UInt >
-            std::vector< T > templated_decode( std::string_view input ) const
+            template < typename Source,
+                typename Target,
+                typename UInt,
+                typename Stream >
+            std::vector< Target > templated_decode( Stream& stream ) const
             {
-                const auto fixed_header_length = nb_char_needed< UInt >( 3 );
-                auto fixed_header = input.substr( 0, fixed_header_length );
-                const auto decoded_fixed_header = decode_base64( fixed_header );
-                const auto fixed_header_values =
-                    reinterpret_cast< const UInt* >(
-                        decoded_fixed_header.c_str() );
+                // Header is [nb blocks, block size, last block size,
+                // compressed block sizes...], followed by compressed blocks
+                std::array< UInt, 3 > fixed_header_values;
+                stream.read( to_bytes( fixed_header_values ) );
                 const auto nb_data_blocks = fixed_header_values[0];
                 if( nb_data_blocks == 0 )
                 {
-                    return std::vector< T >{};
+                    return std::vector< Target >{};
                 }
                 const auto uncompressed_block_size = fixed_header_values[1];
-                const auto nb_characters =
-                    nb_char_needed< UInt >( nb_data_blocks );
-                auto optional_header =
-                    input.substr( fixed_header_length, nb_characters );
-                const auto decoded_optional_header =
-                    decode_base64( optional_header );
-                OpenGeodeIOMeshException::check_exception(
-                    decoded_optional_header.size()
-                        == nb_data_blocks * sizeof( UInt ),
-                    nullptr, OpenGeodeException::TYPE::data,
-                    "[VTKInput::decode] Optional header size is "
-                    "wrong (should be ",
-                    nb_data_blocks * sizeof( UInt ), " bytes, got ",
-                    decoded_optional_header.size(), " bytes)" );
-                const auto optional_header_values =
-                    reinterpret_cast< const UInt* >(
-                        decoded_optional_header.c_str() );
-                UInt sum_compressed_block_size{ 0 };
+                const auto last_block_size = fixed_header_values[2] == 0
+                                                 ? uncompressed_block_size
+                                                 : fixed_header_values[2];
+                check_nb_bytes< Source >( uncompressed_block_size );
                 absl::FixedArray< UInt > compressed_blocks_size(
                     nb_data_blocks );
+                stream.read( to_bytes( compressed_blocks_size ) );
+                stream.end_stream();
+                absl::FixedArray< size_t > compressed_blocks_offset(
+                    nb_data_blocks + 1 );
+                compressed_blocks_offset[0] = 0;
                 for( const auto b : Range{ nb_data_blocks } )
                 {
-                    compressed_blocks_size[b] = optional_header_values[b];
-                    sum_compressed_block_size += optional_header_values[b];
-                }
-
-                const auto data_offset =
-                    nb_char_needed< UInt >( 3 + nb_data_blocks );
-                const auto nb_data_char = static_cast< size_t >(
-                    std::ceil( sum_compressed_block_size * 4. / 3. ) );
-                auto data = input.substr( data_offset, nb_data_char );
-                const auto decoded_data = decode_base64( data );
-                const auto compressed_data_bytes =
-                    reinterpret_cast< const unsigned char* >(
-                        decoded_data.c_str() );
-
-                std::vector< T > result;
-                result.reserve( static_cast< size_t >(
-                    std::ceil( nb_data_blocks * uncompressed_block_size
-                               / sizeof( T ) ) ) );
-                UInt cur_data_offset{ 0 };
-                for( const auto b : Range{ nb_data_blocks } )
-                {
-                    const auto compressed_data_length =
-                        sum_compressed_block_size;
-                    unsigned long decompressed_data_length =
-                        uncompressed_block_size;
-                    absl::FixedArray< uint8_t > decompressed_data_bytes(
-                        decompressed_data_length );
-                    const auto uncompress_result =
-                        uncompress( decompressed_data_bytes.data(),
-                            &decompressed_data_length,
-                            &compressed_data_bytes[cur_data_offset],
-                            compressed_data_length );
-                    OpenGeodeIOMeshException::check_exception(
-                        uncompress_result == Z_OK, nullptr,
-                        OpenGeodeException::TYPE::data,
-                        "[VTKInput::decode] Error in zlib decompressing data" );
-                    const auto values = reinterpret_cast< const T* >(
-                        decompressed_data_bytes.data() );
-                    const auto nb_values =
-                        decompressed_data_length / sizeof( T );
-                    for( const auto v : Range{ nb_values } )
-                    {
-                        result.push_back( values[v] );
-                    }
-                    cur_data_offset += compressed_blocks_size[b];
+                    compressed_blocks_offset[b + 1] =
+                        compressed_blocks_offset[b] + compressed_blocks_size[b];
                 }
+                const auto compressed_data =
+                    stream.read_view( compressed_blocks_offset.back() );
+
+                const auto nb_bytes =
+                    static_cast< size_t >( nb_data_blocks - 1 )
+                        * uncompressed_block_size
+                    + last_block_size;
+                check_nb_bytes< Source >( nb_bytes );
+                // Every block is decompressed straight into its final slot of
+                // the output, blocks being independent compressed streams.
+                // Converted values go through a buffer of a single block.
+                std::vector< Target > result( nb_bytes / sizeof( Source ) );
+                const auto block_nb_values =
+                    static_cast< size_t >( uncompressed_block_size )
+                    / sizeof( Source );
+                async::parallel_for(
+                    async::irange( UInt{ 0 }, nb_data_blocks ),
+                    [&]( UInt b ) {
+                        const auto expected_length =
+                            b + 1 == nb_data_blocks ? last_block_size
+                                                    : uncompressed_block_size;
+                        const auto compressed_block = compressed_data.substr(
+                            compressed_blocks_offset[b],
+                            compressed_blocks_offset[b + 1]
+                                - compressed_blocks_offset[b] );
+                        auto* output = result.data() + b * block_nb_values;
+                        if constexpr( std::is_same_v< Source, Target > )
+                        {
+                            compressor_.decompress_block( compressed_block,
+                                { reinterpret_cast< char* >( output ),
+                                    expected_length } );
+                        }
+                        else
+                        {
+                            std::vector< Source > values(
+                                expected_length / sizeof( Source ) );
+                            compressor_.decompress_block(
+                                compressed_block, to_bytes( values ) );
+                            convert_values< Source, Target >( values, output );
+                        }
+                    } );
                 return result;
             }
 
-            std::string decode_base64( std::string_view input ) const
+            /*!
+             * Number of bytes of the header and of the (compressed) values
+             */
+            template < typename Stream >
+            std::pair< size_t, size_t > encoded_sizes( Stream& stream ) const
             {
-                std::string bytes;
-                auto decode_status = absl::Base64Unescape( input, &bytes );
-                OpenGeodeIOMeshException::check_exception( decode_status,
-                    nullptr, OpenGeodeException::TYPE::data,
-                    "[VTKInput::decode_base64] Error in decoding base64 data" );
-                return bytes;
+                if( is_uint64_ )
+                {
+                    return templated_encoded_sizes< uint64_t >( stream );
+                }
+                return templated_encoded_sizes< uint32_t >( stream );
             }
 
-            template < typename T >
-            std::vector< T > read_ascii_data_array( std::string_view data,
-                bool ( *string_convert )( std::string_view, T* ) ) const
+            template < typename UInt, typename Stream >
+            std::pair< size_t, size_t > templated_encoded_sizes(
+                Stream& stream ) const
             {
-                std::vector< T > results;
-                for( auto string : absl::StrSplit( data, ' ' ) )
+                if( !compressor_.is_compressed() )
                 {
-                    T value;
-                    const auto ok = ( *string_convert )( string, &value );
-                    OpenGeodeIOMeshException::check_exception( ok, nullptr,
-                        OpenGeodeException::TYPE::data,
-                        "[VTKINPUT::read_ascii_data_array] Failed to read "
-                        "value" );
-                    results.push_back( value );
+                    UInt nb_bytes;
+                    stream.read( value_bytes( nb_bytes ) );
+                    return { sizeof( UInt ), nb_bytes };
                 }
-                return results;
+                std::array< UInt, 3 > fixed_header_values;
+                stream.read( to_bytes( fixed_header_values ) );
+                absl::FixedArray< UInt > compressed_blocks_size(
+                    fixed_header_values[0] );
+                stream.read( to_bytes( compressed_blocks_size ) );
+                size_t nb_bytes{ 0 };
+                for( const auto block_size : compressed_blocks_size )
+                {
+                    nb_bytes += block_size;
+                }
+                const auto nb_header_values = 3 + compressed_blocks_size.size();
+                return { sizeof( UInt ) * nb_header_values, nb_bytes };
             }
 
             template < typename T >
-            std::vector< T > read_ascii_integer_data_array(
-                std::string_view data ) const
+            void check_nb_bytes( size_t nb_bytes ) const
             {
-                return read_ascii_data_array< T >( data, absl::SimpleAtoi );
+                OpenGeodeIOMeshException::check_exception(
+                    nb_bytes % sizeof( T ) == 0, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTKInput::decode] Data size is not a multiple of the "
+                    "value type size" );
             }
 
             template < typename T >
-            std::vector< T > read_ascii_uint8_data_array(
-                std::string_view data ) const
+            static absl::Span< char > value_bytes( T& value )
             {
-                std::vector< T > results;
-                for( auto string : absl::StrSplit( data, ' ' ) )
-                {
-                    results.push_back(
-                        std::atoi( to_string( string ).c_str() ) );
-                }
-                return results;
+                return { reinterpret_cast< char* >( &value ), sizeof( T ) };
             }
 
-            template < typename T >
-            std::vector< T > read_ascii_float_data_array(
-                std::string_view data ) const
+            template < typename Container >
+            static absl::Span< char > to_bytes( Container& values )
             {
-                return read_ascii_data_array< T >( data, absl::SimpleAtod );
+                return { reinterpret_cast< char* >( values.data() ),
+                    values.size()
+                        * sizeof( typename Container::value_type ) };
             }
 
         private:
-            std::ifstream file_;
+            static constexpr size_t CONVERSION_CHUNK_SIZE{ 1024 };
+
+            std::string filename_;
+            std::optional< VTKDocument > document_;
             std::unique_ptr< Mesh > mesh_;
-            pugi::xml_document document_;
             pugi::xml_node root_;
             const char* type_;
+            std::string partitioned_type_;
+            VTKInputOptions options_;
             bool little_endian_{ true };
-            bool compressed_{ false };
+            VTKCompressor compressor_{ VTK_COMPRESSOR::none };
             bool is_uint64_{ false };
             std::string_view appended_data_;
+            absl::flat_hash_set<
+                std::pair< const AttributeManager*, std::string > >
+                created_attributes_;
+            absl::flat_hash_map< std::pair< std::string, std::string >,
+                ATTRIBUTE_VALUE_TYPE >
+                attribute_value_types_;
         }; // namespace detail
     } // namespace detail
 } // namespace geode
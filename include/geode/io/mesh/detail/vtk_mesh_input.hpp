@@ -29,22 +29,97 @@
 
 #include <pugixml.hpp>
 
-#include <zlib.h>
-
+#include <absl/algorithm/container.h>
+#include <absl/container/fixed_array.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/strings/escaping.h>
-#include <absl/strings/str_split.h>
+#include <absl/strings/ascii.h>
+#include <absl/types/span.h>
 
 #include <geode/basic/attribute_manager.hpp>
 #include <geode/basic/string.hpp>
 
 #include <geode/geometry/point.hpp>
 
+#include <geode/io/mesh/detail/vtk_adjacency.hpp>
+#include <geode/io/mesh/detail/vtk_cell_types_cache.hpp>
 #include <geode/io/mesh/detail/vtk_input.hpp>
+#include <geode/io/mesh/mesh_input_options.hpp>
 
 namespace geode
 {
     namespace detail
     {
+        /*!
+         * Vertices of the cells of a VTK piece, stored contiguously
+         * (compressed sparse row layout). As in VTK files, offsets are the
+         * end offsets of the cells: the vertices of cell c are stored
+         * between offsets[c - 1] (0 for the first cell) and offsets[c].
+         */
+        class VTKCells
+        {
+        public:
+            index_t nb_cells() const
+            {
+                return static_cast< index_t >( offsets.size() );
+            }
+
+            index_t cell_begin( index_t cell ) const
+            {
+                return cell == 0 ? 0 : offsets[cell - 1];
+            }
+
+            index_t nb_cell_vertices( index_t cell ) const
+            {
+                return offsets[cell] - cell_begin( cell );
+            }
+
+            absl::Span< const index_t > cell_vertices( index_t cell ) const
+            {
+                return absl::MakeConstSpan( vertices )
+                    .subspan( cell_begin( cell ), nb_cell_vertices( cell ) );
+            }
+
+            bool has_faces() const
+            {
+                return !cell_face_offsets.empty();
+            }
+
+            Range cell_faces( index_t cell ) const
+            {
+                return { cell_face_offsets[cell],
+                    cell_face_offsets[cell + 1] };
+            }
+
+            absl::Span< const index_t > face_vertices( index_t face ) const
+            {
+                return absl::MakeConstSpan( vertices ).subspan(
+                    face_offsets[face],
+                    face_offsets[face + 1] - face_offsets[face] );
+            }
+
+        public:
+            std::vector< index_t > offsets;
+            /*!
+             * Vertices of the cells, followed by the vertices of the cell
+             * faces if any
+             */
+            std::vector< index_t > vertices;
+            /*!
+             * Faces of the cells, if given by the file (e.g. faces of
+             * VTK_POLYHEDRON cells), as a flat CSR: faces of cell c are
+             * [cell_face_offsets[c], cell_face_offsets[c + 1]) and vertices
+             * of face f are in vertices [face_offsets[f],
+             * face_offsets[f + 1]).
+             */
+            std::vector< index_t > cell_face_offsets;
+            std::vector< index_t > face_offsets;
+            /*!
+             * VTK types of the cells, if given by the file
+             */
+            VTKCellTypes types;
+        };
+
         template < typename Mesh >
         class VTKMeshInputImpl : public VTKInputImpl< Mesh >
         {
@@ -54,7 +129,11 @@ namespace geode
             VTKMeshInputImpl( std::string_view filename,
                 const MeshImpl& impl,
                 const char* type )
-                : VTKInputImpl< Mesh >{ filename, type }
+                : VTKInputImpl< Mesh >{ filename, type },
+                  mesh_impl_{ impl },
+                  compute_adjacencies_{
+                      mesh_input_options().compute_adjacencies
+                  }
             {
                 this->initialize_mesh( Mesh::create( impl ) );
                 mesh_builder_ = MeshBuilder::create( this->mesh() );
@@ -65,36 +144,321 @@ namespace geode
                 return *mesh_builder_;
             }
 
-            absl::FixedArray< std::vector< index_t > > get_cell_vertices(
-                absl::Span< const int64_t > connectivity,
-                absl::Span< const int64_t > offsets ) const
+            const MeshImpl& mesh_impl() const
+            {
+                return mesh_impl_;
+            }
+
+            VTKCells get_cell_vertices( std::vector< index_t > connectivity,
+                std::vector< index_t > offsets ) const
             {
-                absl::FixedArray< std::vector< index_t > > cell_vertices(
-                    offsets.size() );
-                int64_t prev_offset{ 0 };
-                for( const auto p : Indices{ offsets } )
+                index_t prev_offset{ 0 };
+                for( const auto offset : offsets )
                 {
-                    const auto cur_offset = offsets[p];
-                    auto& vertices = cell_vertices[p];
-                    vertices.reserve( cur_offset - prev_offset );
-                    for( const auto v : Range{ prev_offset, cur_offset } )
-                    {
-                        vertices.push_back(
-                            static_cast< index_t >( connectivity[v] ) );
-                    }
-                    prev_offset = cur_offset;
+                    OpenGeodeIOMeshException::check_exception(
+                        prev_offset <= offset && offset <= connectivity.size(),
+                        nullptr, OpenGeodeException::TYPE::data,
+                        "[VTKInput::get_cell_vertices] Wrong cell offsets" );
+                    prev_offset = offset;
                 }
-                return cell_vertices;
+                VTKCells cells;
+                cells.offsets = std::move( offsets );
+                cells.vertices = std::move( connectivity );
+                return cells;
             }
 
         private:
+            struct VTKPiece
+            {
+                index_t nb_points{ 0 };
+                std::vector< double > coordinates;
+                std::vector< VTKDataArrayValues > point_data;
+                VTKCells cells;
+                std::vector< VTKDataArrayValues > cell_data;
+            };
+
             void read_vtk_object( const pugi::xml_node& vtk_object ) final
             {
+                std::vector< pugi::xml_node > pieces;
                 for( const auto& piece : vtk_object.children( "Piece" ) )
                 {
-                    read_vtk_points( piece );
-                    read_vtk_cells( piece );
+                    pieces.push_back( piece );
+                }
+                // Piece connectivities refer to piece vertices: vertices
+                // of each piece are shifted by the vertices of the previous
+                // pieces
+                absl::FixedArray< index_t > vertex_offsets( pieces.size() );
+                auto nb_vertices = this->mesh().nb_vertices();
+                for( const auto p : Indices{ pieces } )
+                {
+                    vertex_offsets[p] = nb_vertices;
+                    nb_vertices +=
+                        this->read_attribute( pieces[p], "NumberOfPoints" );
+                }
+                if( pieces.size() == 1 )
+                {
+                    // Stored adjacencies refer to the cells of the piece
+                    build_cell_adjacencies( build_piece(
+                        decode_piece( pieces.front(), vertex_offsets[0] ) ) );
+                    return;
+                }
+                if( this->options().parallel_pieces )
+                {
+                    absl::FixedArray< VTKPiece > decoded_pieces(
+                        pieces.size() );
+                    async::parallel_for(
+                        async::irange( size_t{ 0 }, pieces.size() ),
+                        [&]( size_t p ) {
+                            decoded_pieces[p] =
+                                decode_piece( pieces[p], vertex_offsets[p] );
+                        } );
+                    for( auto& piece : decoded_pieces )
+                    {
+                        build_piece( std::move( piece ) );
+                    }
+                }
+                else
+                {
+                    for( const auto p : Indices{ pieces } )
+                    {
+                        build_piece(
+                            decode_piece( pieces[p], vertex_offsets[p] ) );
+                    }
+                }
+                build_cell_adjacencies( std::nullopt );
+            }
+
+            /*!
+             * Set the cell adjacencies stored by the file, or compute them
+             * if they are missing or stale. Nothing is done when the mesh
+             * input options defer adjacencies.
+             */
+            void build_cell_adjacencies(
+                const std::optional< VTKDataArrayValues >& adjacencies )
+            {
+                if( !compute_adjacencies_ )
+                {
+                    return;
                 }
+                if( adjacencies
+                    && set_stored_adjacencies( adjacencies.value() ) )
+                {
+                    return;
+                }
+                compute_vtk_cell_adjacencies();
+            }
+
+            void read_partitioned_file(
+                const pugi::xml_node& /*unused*/ ) final
+            {
+                const auto readers = this->open_piece_readers();
+                std::vector< const VTKMeshInputImpl* > piece_readers;
+                std::vector< pugi::xml_node > pieces;
+                for( const auto& reader : readers )
+                {
+                    // Piece readers are created by create_piece_reader(),
+                    // which returns readers of the same kind
+                    const auto& piece_reader =
+                        static_cast< const VTKMeshInputImpl& >( *reader );
+                    for( const auto& piece : piece_reader.piece_nodes() )
+                    {
+                        piece_readers.push_back( &piece_reader );
+                        pieces.push_back( piece );
+                    }
+                }
+                // Pieces are first numbered as if they were concatenated,
+                // then duplicated interface vertices are merged
+                absl::FixedArray< index_t > vertex_offsets(
+                    pieces.size() + 1 );
+                vertex_offsets[0] = 0;
+                for( const auto p : Indices{ pieces } )
+                {
+                    vertex_offsets[p + 1] =
+                        vertex_offsets[p]
+                        + this->read_attribute( pieces[p], "NumberOfPoints" );
+                }
+                absl::FixedArray< VTKPiece > decoded_pieces( pieces.size() );
+                const auto decode = [&]( size_t p ) {
+                    decoded_pieces[p] = piece_readers[p]->decode_piece(
+                        pieces[p], vertex_offsets[p] );
+                };
+                if( this->options().parallel_pieces )
+                {
+                    async::parallel_for(
+                        async::irange( size_t{ 0 }, pieces.size() ), decode );
+                }
+                else
+                {
+                    for( const auto p : Indices{ pieces } )
+                    {
+                        decode( p );
+                    }
+                }
+                const auto vertex_mapping =
+                    merge_piece_vertices( absl::MakeSpan( decoded_pieces ),
+                        pieces, piece_readers, vertex_offsets );
+                const auto first_vertex = this->builder().create_vertices(
+                    vertex_mapping.nb_vertices );
+                for( const auto p : Indices{ decoded_pieces } )
+                {
+                    auto& piece = decoded_pieces[p];
+                    const auto piece_vertex = [&]( index_t v ) {
+                        return first_vertex
+                               + vertex_mapping
+                                     .vertices[vertex_offsets[p] + v];
+                    };
+                    const auto& coords = piece.coordinates;
+                    for( const auto v : Range{ piece.nb_points } )
+                    {
+                        this->builder().set_point( piece_vertex( v ),
+                            Point3D{ { coords[3 * v], coords[3 * v + 1],
+                                coords[3 * v + 2] } } );
+                    }
+                    this->store_data( piece.point_data, piece_vertex,
+                        this->mesh().vertex_attribute_manager() );
+                    for( auto& vertex : piece.cells.vertices )
+                    {
+                        vertex = first_vertex + vertex_mapping.vertices[vertex];
+                    }
+                    const auto cell_offset = build_vtk_cells( piece.cells );
+                    extract_adjacencies( piece.cell_data );
+                    this->store_data( piece.cell_data, cell_offset,
+                        vtk_cell_attribute_manager() );
+                    piece = {};
+                }
+                build_cell_adjacencies( std::nullopt );
+            }
+
+            struct VTKVertexMapping
+            {
+                index_t nb_vertices{ 0 };
+                std::vector< index_t > vertices;
+            };
+
+            /*!
+             * Map the concatenated vertices of the pieces to unique
+             * vertices. Vertices of different piece files are merged when
+             * they share the same global id (given by the GlobalIds
+             * attribute of PointData) or, without global ids, the same
+             * coordinates. Vertices of the same file are never merged.
+             * Global ids are not stored as an attribute.
+             */
+            static VTKVertexMapping merge_piece_vertices(
+                absl::Span< VTKPiece > decoded_pieces,
+                absl::Span< const pugi::xml_node > pieces,
+                absl::Span< const VTKMeshInputImpl* const > piece_readers,
+                absl::Span< const index_t > vertex_offsets )
+            {
+                std::vector< std::vector< index_t > > global_ids;
+                bool has_global_ids{ true };
+                for( const auto p : Indices{ pieces } )
+                {
+                    auto& ids = global_ids.emplace_back(
+                        extract_global_ids( decoded_pieces[p], pieces[p] ) );
+                    if( ids.empty() && decoded_pieces[p].nb_points > 0 )
+                    {
+                        has_global_ids = false;
+                    }
+                }
+                if( !has_global_ids )
+                {
+                    return merge_vertices< std::array< double, 3 > >(
+                        decoded_pieces, piece_readers, vertex_offsets,
+                        [&decoded_pieces]( index_t p, index_t v ) {
+                            const auto* coords =
+                                &decoded_pieces[p].coordinates[3 * v];
+                            return std::array< double, 3 >{ coords[0],
+                                coords[1], coords[2] };
+                        } );
+                }
+                return merge_vertices< index_t >( decoded_pieces,
+                    piece_readers, vertex_offsets,
+                    [&global_ids]( index_t p, index_t v ) {
+                        return global_ids[p][v];
+                    } );
+            }
+
+            template < typename Key, typename KeyGetter >
+            static VTKVertexMapping merge_vertices(
+                absl::Span< const VTKPiece > decoded_pieces,
+                absl::Span< const VTKMeshInputImpl* const > piece_readers,
+                absl::Span< const index_t > vertex_offsets,
+                const KeyGetter& vertex_key )
+            {
+                VTKVertexMapping mapping;
+                mapping.vertices.resize( vertex_offsets.back() );
+                // Key to (unique vertex, reader of its first occurrence)
+                absl::flat_hash_map< Key,
+                    std::pair< index_t, const VTKMeshInputImpl* > >
+                    unique_vertices;
+                unique_vertices.reserve( vertex_offsets.back() );
+                for( const auto p : Indices{ decoded_pieces } )
+                {
+                    const auto* reader = piece_readers[p];
+                    for( const auto v : Range{ decoded_pieces[p].nb_points } )
+                    {
+                        const auto it = unique_vertices.try_emplace(
+                            vertex_key( p, v ), mapping.nb_vertices, reader );
+                        auto& vertex = mapping.vertices[vertex_offsets[p] + v];
+                        if( it.second || it.first->second.second == reader )
+                        {
+                            vertex = mapping.nb_vertices++;
+                        }
+                        else
+                        {
+                            vertex = it.first->second.first;
+                        }
+                    }
+                }
+                return mapping;
+            }
+
+            /*!
+             * Remove the GlobalIds array from the piece PointData.
+             * @return its ids, or nothing if they are missing or invalid.
+             */
+            static std::vector< index_t > extract_global_ids(
+                VTKPiece& piece, const pugi::xml_node& piece_node )
+            {
+                const std::string_view name = piece_node.child( "PointData" )
+                                                  .attribute( "GlobalIds" )
+                                                  .value();
+                if( name.empty() )
+                {
+                    return {};
+                }
+                const auto it = absl::c_find_if( piece.point_data,
+                    [name]( const VTKDataArrayValues& array ) {
+                        return array.name == name;
+                    } );
+                if( it == piece.point_data.end() )
+                {
+                    return {};
+                }
+                auto array = std::move( *it );
+                piece.point_data.erase( it );
+                if( array.nb_components != 1 )
+                {
+                    return {};
+                }
+                if( const auto* ids =
+                        std::get_if< std::vector< index_t > >( &array.values );
+                    ids && ids->size() == piece.nb_points )
+                {
+                    return *ids;
+                }
+                // Signed ids (e.g. VTK Int64 ids) are kept if they are all
+                // valid indices
+                const auto* ids =
+                    std::get_if< std::vector< long int > >( &array.values );
+                if( ids && ids->size() == piece.nb_points
+                    && absl::c_all_of( *ids, []( long int id ) {
+                           return id >= 0 && id < NO_ID;
+                       } ) )
+                {
+                    return { ids->begin(), ids->end() };
+                }
+                return {};
             }
 
             void is_vtk_object_loadable( const pugi::xml_node& vtk_object,
@@ -106,56 +470,134 @@ namespace geode
                 }
             }
 
-            void read_vtk_points( const pugi::xml_node& piece )
+            VTKPiece decode_piece(
+                const pugi::xml_node& piece, index_t vertex_offset ) const
             {
-                const auto nb_points =
+                VTKPiece result;
+                result.nb_points =
                     this->read_attribute( piece, "NumberOfPoints" );
-                const auto vertex_offset = build_points( piece, nb_points );
-                this->read_data( piece.child( "PointData" ), vertex_offset,
+                result.coordinates =
+                    read_coordinates( piece, result.nb_points );
+                result.point_data =
+                    this->decode_data( piece.child( "PointData" ) );
+                result.cells = read_vtk_cells( piece );
+                if( vertex_offset != 0 )
+                {
+                    for( auto& vertex : result.cells.vertices )
+                    {
+                        vertex += vertex_offset;
+                    }
+                }
+                result.cell_data =
+                    this->decode_data( piece.child( "CellData" ) );
+                return result;
+            }
+
+            /*!
+             * Build the piece elements and attributes.
+             * @return the adjacencies stored by the piece, if any.
+             */
+            std::optional< VTKDataArrayValues > build_piece( VTKPiece&& piece )
+            {
+                const auto vertex_offset =
+                    build_points( piece.coordinates, piece.nb_points );
+                piece.coordinates = {};
+                this->store_data( piece.point_data, vertex_offset,
                     this->mesh().vertex_attribute_manager() );
+                piece.point_data = {};
+                const auto cell_offset = build_vtk_cells( piece.cells );
+                piece.cells = {};
+                auto adjacencies = extract_adjacencies( piece.cell_data );
+                this->store_data( piece.cell_data, cell_offset,
+                    vtk_cell_attribute_manager() );
+                return adjacencies;
             }
 
-            virtual void read_vtk_cells( const pugi::xml_node& piece ) = 0;
+            /*!
+             * Remove the stored adjacencies from the cell data, so that
+             * they are not created as an attribute
+             */
+            static std::optional< VTKDataArrayValues > extract_adjacencies(
+                std::vector< VTKDataArrayValues >& cell_data )
+            {
+                const auto it = absl::c_find_if(
+                    cell_data, []( const VTKDataArrayValues& array ) {
+                        return array.name == VTK_ADJACENCY_ARRAY;
+                    } );
+                if( it == cell_data.end() )
+                {
+                    return std::nullopt;
+                }
+                auto adjacencies = std::move( *it );
+                cell_data.erase( it );
+                return adjacencies;
+            }
+
+            bool set_stored_adjacencies( const VTKDataArrayValues& array )
+            {
+                std::vector< int64_t > adjacencies;
+                std::visit(
+                    [&adjacencies]( const auto& values ) {
+                        using Values = std::decay_t< decltype( values ) >;
+                        if constexpr( !std::is_same_v< Values,
+                                          std::monostate > )
+                        {
+                            adjacencies.assign( values.begin(), values.end() );
+                        }
+                    },
+                    array.values );
+                return set_vtk_cell_adjacencies(
+                    adjacencies, array.nb_components );
+            }
+
+            /*!
+             * Decode the cells of a piece. Pieces may be decoded
+             * concurrently.
+             */
+            virtual VTKCells read_vtk_cells(
+                const pugi::xml_node& piece ) const = 0;
+
+            /*!
+             * Create the mesh elements of decoded cells.
+             * @return the index of the first created element.
+             */
+            virtual index_t build_vtk_cells( const VTKCells& cells ) = 0;
+
+            virtual AttributeManager& vtk_cell_attribute_manager() = 0;
+
+            virtual void compute_vtk_cell_adjacencies() = 0;
+
+            /*!
+             * Set the cell adjacencies stored by the file.
+             * @return false if they are not supported or not consistent
+             * with the built cells, which are then left unchanged.
+             */
+            virtual bool set_vtk_cell_adjacencies(
+                absl::Span< const int64_t > /*unused*/,
+                index_t /*unused*/ )
+            {
+                return false;
+            }
 
             virtual Percentage is_vtk_cells_loadable(
                 const pugi::xml_node& piece ) const = 0;
 
             index_t build_points(
-                const pugi::xml_node& piece, index_t nb_points )
+                absl::Span< const double > coords, index_t nb_points )
             {
-                const auto points = read_points( piece, nb_points );
                 const auto offset =
                     this->builder().create_vertices( nb_points );
                 for( const auto p : Range{ nb_points } )
                 {
-                    this->builder().set_point( offset + p, points[p] );
+                    this->builder().set_point( offset + p,
+                        Point3D{ { coords[3 * p], coords[3 * p + 1],
+                            coords[3 * p + 2] } } );
                 }
                 return offset;
             }
 
-            template < typename T >
-            absl::FixedArray< Point3D > get_points(
-                const std::vector< T >& coords )
-            {
-                OpenGeodeIOMeshException::check_exception(
-                    coords.size() % 3 == 0, nullptr,
-                    OpenGeodeException::TYPE::data,
-                    "[VTKInput::get_points] Number of coordinates is not "
-                    "multiple of 3" );
-                const auto nb_points = coords.size() / 3;
-                absl::FixedArray< Point3D > points( nb_points );
-                for( const auto p : Range{ nb_points } )
-                {
-                    for( const auto c : Range{ 3 } )
-                    {
-                        points[p].set_value( c, coords[3 * p + c] );
-                    }
-                }
-                return points;
-            }
-
-            absl::FixedArray< Point3D > read_points(
-                const pugi::xml_node& piece, index_t nb_points )
+            std::vector< double > read_coordinates(
+                const pugi::xml_node& piece, index_t nb_points ) const
             {
                 const auto points =
                     piece.child( "Points" ).child( "DataArray" );
@@ -166,75 +608,26 @@ namespace geode
                     this->match( type, "Float32" )
                         || this->match( type, "Float64" ),
                     nullptr, OpenGeodeException::TYPE::data,
-                    "[VTKInput::read_points] Cannot read points of type ", type,
-                    ". Only Float32 and Float64 are accepted" );
+                    "[VTKInput::read_coordinates] Cannot read points of type ",
+                    type, ". Only Float32 and Float64 are accepted" );
                 OpenGeodeIOMeshException::check_exception( nb_components == 3,
                     nullptr, OpenGeodeException::TYPE::data,
-                    "[VTKInput::read_points] Trying to import 2D VTK object "
-                    "into a 3D Surface is not allowed" );
-                const auto format = points.attribute( "format" ).value();
-                if( this->match( format, "appended" ) )
-                {
-                    if( this->match( type, "Float32" ) )
-                    {
-                        return decode_points< float >(
-                            this->read_appended_data( points ), nb_points );
-                    }
-                    return decode_points< double >(
-                        this->read_appended_data( points ), nb_points );
-                }
-                else
-                {
-                    const auto coords_string =
-                        absl::StripAsciiWhitespace( points.child_value() );
-                    if( this->match( format, "ascii" ) )
-                    {
-                        auto string = to_string( coords_string );
-                        absl::RemoveExtraAsciiWhitespace( &string );
-                        const auto coords =
-                            read_ascii_coordinates( string, nb_points );
-                        OpenGeodeIOMeshException::check_exception(
-                            coords.size() == 3 * nb_points, nullptr,
-                            OpenGeodeException::TYPE::data,
-                            "[VTKInput::read_points] Wrong number of "
-                            "coordinates" );
-                        return get_points( coords );
-                    }
-                    if( this->match( type, "Float32" ) )
-                    {
-                        return decode_points< float >(
-                            coords_string, nb_points );
-                    }
-                    return decode_points< double >( coords_string, nb_points );
-                }
-            }
-
-            template < typename T >
-            absl::FixedArray< Point3D > decode_points(
-                std::string_view coords_string, index_t nb_points )
-            {
-                const auto coords = this->template decode< T >( coords_string );
+                    "[VTKInput::read_coordinates] Trying to import 2D VTK "
+                    "object into a 3D Surface is not allowed" );
+                auto coords =
+                    this->template read_data_array< double >( points );
                 OpenGeodeIOMeshException::check_exception(
-                    coords.size() == 3 * nb_points, nullptr,
-                    OpenGeodeException::TYPE::data,
-                    "[VTKInput::read_points] Wrong number of coordinates" );
-                return get_points( coords );
-            }
-
-            std::vector< double > read_ascii_coordinates(
-                std::string_view coords, index_t nb_points )
-            {
-                std::vector< double > results;
-                results.reserve( 3 * nb_points );
-                for( auto string : absl::StrSplit( coords, ' ' ) )
-                {
-                    results.push_back( string_to_double( string ) );
-                }
-                return results;
+                    coords.size() == 3 * static_cast< size_t >( nb_points ),
+                    nullptr, OpenGeodeException::TYPE::data,
+                    "[VTKInput::read_coordinates] Wrong number of "
+                    "coordinates" );
+                return coords;
             }
 
         private:
+            MeshImpl mesh_impl_;
             std::unique_ptr< MeshBuilder > mesh_builder_;
+            bool compute_adjacencies_;
         }; // namespace detail
     } // namespace detail
 } // namespace geode
@@ -25,29 +25,16 @@
 
 #include <geode/io/image/detail/vtk_output.hpp>
 
+#include <limits>
+
 #include <geode/basic/attribute_manager.hpp>
 
-#include <geode/geometry/bounding_box.hpp>
 #include <geode/geometry/point.hpp>
 
 namespace geode
 {
     namespace detail
     {
-        template < index_t dimension >
-        inline void write_point(
-            std::string& string, const Point< dimension >& point )
-        {
-            if( dimension < 3 )
-            {
-                absl::StrAppend( &string, point.string(), " 0 " );
-            }
-            else
-            {
-                absl::StrAppend( &string, point.string(), " " );
-            }
-        }
-
         template < template < index_t > class Mesh, index_t dimension >
         class VTKMeshOutputImpl : public VTKOutputImpl< Mesh< dimension > >
         {
@@ -67,68 +54,81 @@ namespace geode
             }
 
         private:
-            void write_piece( pugi::xml_node& object ) final
+            void write_piece() final
             {
-                auto piece = object.append_child( "Piece" );
+                auto& xml = this->xml();
+                xml.start_element( "Piece" );
                 const auto vertices = compute_vertices();
-                piece.append_attribute( "NumberOfPoints" )
-                    .set_value( vertices.size() );
-                append_number_elements( piece );
+                xml.add_attribute( "NumberOfPoints", vertices.size() );
+                append_number_elements();
 
-                auto vertex_node =
-                    write_vtk_vertex_attributes( piece, vertices );
-                write_vtk_textures( vertex_node );
-                write_vtk_points( piece, vertices );
-                write_vtk_cell_attributes( piece );
-                write_vtk_cells( piece );
+                xml.start_element( "PointData" );
+                write_vtk_global_ids( vertices );
+                this->write_attributes(
+                    this->mesh().vertex_attribute_manager(), vertices );
+                write_vtk_textures();
+                xml.end_element();
+                write_vtk_points( vertices );
+                write_vtk_cell_attributes();
+                write_vtk_cells();
+                xml.end_element();
             }
 
-            pugi::xml_node write_vtk_points( pugi::xml_node& piece,
-                absl::Span< const index_t > vertices ) const
+            void write_vtk_points( absl::Span< const index_t > vertices )
             {
-                auto points = piece.append_child( "Points" );
+                auto& xml = this->xml();
+                xml.start_element( "Points" );
                 if( vertices.size() == 0 )
                 {
-                    return points;
-                }
-                auto data_array =
-                    this->write_attribute_header( points, "Points", 3 );
-                const auto bbox = this->mesh().bounding_box();
-                auto min = bbox.min().value( 0 );
-                auto max = bbox.max().value( 0 );
-                for( const auto d : Range{ 1, dimension } )
-                {
-                    min = std::min( min, bbox.min().value( d ) );
-                    max = std::max( max, bbox.max().value( d ) );
+                    xml.end_element();
+                    return;
                 }
-                data_array.append_attribute( "RangeMin" ).set_value( min );
-                data_array.append_attribute( "RangeMax" ).set_value( max );
-                std::string vertices_str;
+                // Range of the written vertices only, which may be a piece
+                // of the mesh
+                auto min = std::numeric_limits< double >::max();
+                auto max = std::numeric_limits< double >::lowest();
+                std::vector< double > coordinates;
+                coordinates.reserve( 3 * vertices.size() );
                 for( const auto v : vertices )
                 {
-                    write_point( vertices_str, this->mesh().point( v ) );
+                    const auto& point = this->mesh().point( v );
+                    for( const auto d : LRange{ 3 } )
+                    {
+                        if( d >= dimension )
+                        {
+                            coordinates.push_back( 0. );
+                            continue;
+                        }
+                        const auto value = point.value( d );
+                        min = std::min( min, value );
+                        max = std::max( max, value );
+                        coordinates.push_back( value );
+                    }
                 }
-                data_array.text().set( vertices_str.c_str() );
-                return points;
+                this->write_coordinates_data_array(
+                    "Points", 3, coordinates, min, max );
+                xml.end_element();
             }
 
-            pugi::xml_node write_vtk_vertex_attributes( pugi::xml_node& piece,
-                absl::Span< const index_t > vertices ) const
+            virtual void append_number_elements() = 0;
+
+            /*!
+             * Write the global ids of the vertices in the PointData element,
+             * before any other DataArray
+             */
+            virtual void write_vtk_global_ids(
+                absl::Span< const index_t > /*unused*/ )
             {
-                auto point_data = piece.append_child( "PointData" );
-                this->write_attributes( point_data,
-                    this->mesh().vertex_attribute_manager(), vertices );
-                return point_data;
             }
 
-            virtual void append_number_elements( pugi::xml_node& piece ) = 0;
-
-            virtual void write_vtk_textures( pugi::xml_node& /*unused*/ ) {};
+            /*!
+             * Write texture coordinates DataArrays in the PointData element
+             */
+            virtual void write_vtk_textures() {}
 
-            virtual pugi::xml_node write_vtk_cells( pugi::xml_node& piece ) = 0;
+            virtual void write_vtk_cells() = 0;
 
-            virtual pugi::xml_node write_vtk_cell_attributes(
-                pugi::xml_node& piece ) = 0;
+            virtual void write_vtk_cell_attributes() = 0;
         };
     } // namespace detail
 } // namespace geode
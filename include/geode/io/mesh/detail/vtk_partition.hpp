@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <absl/types/span.h>
+
+#include <geode/geometry/point.hpp>
+
+#include <geode/io/mesh/common.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        /*!
+         * Split elements into spatially coherent parts of equal sizes (up to
+         * one element), by recursive bisection of their barycenters along
+         * the longest direction of their bounding box.
+         * @param[in] barycenters Barycenters of the elements.
+         * @return the sorted elements of each part.
+         */
+        [[nodiscard]] std::vector< std::vector< index_t > >
+            opengeode_io_mesh_api partition_elements(
+                absl::Span< const Point3D > barycenters, index_t nb_parts );
+    } // namespace detail
+} // namespace geode
@@ -54,6 +54,12 @@ namespace geode
                 return EXT;
             }
 
+            static std::string_view partitioned_extension()
+            {
+                static constexpr auto EXT = "pvtu";
+                return EXT;
+            }
+
             std::vector< std::string > write(
                 const HybridSolid3D &solid ) const final;
         };
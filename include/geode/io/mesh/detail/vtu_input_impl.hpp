@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <geode/io/mesh/detail/vtk_cell_types_cache.hpp>
 #include <geode/io/mesh/detail/vtk_mesh_input.hpp>
 
 namespace geode
@@ -32,6 +33,26 @@ namespace geode
         template < typename Mesh >
         class VTUInputImpl : public VTKMeshInputImpl< Mesh >
         {
+        public:
+            /*!
+             * Read the file, then drop the cell types kept for it: they are
+             * only shared by the loadability checks and the read of a file.
+             */
+            std::unique_ptr< Mesh > read_file()
+            {
+                try
+                {
+                    auto mesh = VTKMeshInputImpl< Mesh >::read_file();
+                    clear_vtk_cell_types();
+                    return mesh;
+                }
+                catch( ... )
+                {
+                    clear_vtk_cell_types();
+                    throw;
+                }
+            }
+
         protected:
             VTUInputImpl(
                 std::string_view filename, const geode::MeshImpl& impl )
@@ -39,84 +60,97 @@ namespace geode
             {
             }
 
-            std::tuple< absl::FixedArray< std::vector< index_t > >,
-                std::vector< uint8_t > >
-                read_cells(
-                    const pugi::xml_node& piece, index_t nb_cells ) const
+            VTKCells read_cell_vertices(
+                const pugi::xml_node& piece, index_t nb_cells ) const
             {
-                std::vector< int64_t > offsets_values;
-                std::vector< int64_t > connectivity_values;
-                std::vector< uint8_t > types_values;
+                std::vector< index_t > offsets_values;
+                std::vector< index_t > connectivity_values;
                 for( const auto& data :
                     piece.child( "Cells" ).children( "DataArray" ) )
                 {
                     if( this->match(
                             data.attribute( "Name" ).value(), "offsets" ) )
                     {
-                        OpenGeodeIOMeshException::check_exception(
-                            this->match(
-                                data.attribute( "type" ).value(), "Int64" ),
-                            nullptr, OpenGeodeException::TYPE::data,
-                            "[VTUInputImpl::read_cells] Wrong offset type, "
-                            "supports only Int64" );
                         offsets_values =
-                            this->template read_integer_data_array< int64_t >(
-                                data );
+                            this->template read_data_array< index_t >( data );
                         OpenGeodeIOMeshException::check_assertion(
                             offsets_values.size() == nb_cells,
-                            "[VTUInputImpl::read_cells] Wrong number of "
-                            "offsets" );
+                            "[VTUInputImpl::read_cell_vertices] Wrong number "
+                            "of offsets" );
                     }
                     else if( this->match( data.attribute( "Name" ).value(),
                                  "connectivity" ) )
                     {
-                        OpenGeodeIOMeshException::check_exception(
-                            this->match(
-                                data.attribute( "type" ).value(), "Int64" ),
-                            nullptr, OpenGeodeException::TYPE::data,
-                            "[VTUInputImpl::read_cells] Wrong connectivity "
-                            "type, supports only Int64" );
                         connectivity_values =
-                            this->template read_integer_data_array< int64_t >(
-                                data );
-                    }
-                    else if( this->match(
-                                 data.attribute( "Name" ).value(), "types" ) )
-                    {
-                        if( this->match(
-                                data.attribute( "type" ).value(), "UInt8" ) )
-                        {
-                            types_values =
-                                this->template read_uint8_data_array< uint8_t >(
-                                    data );
-                        }
-                        else if( this->match( data.attribute( "type" ).value(),
-                                     "Int32" ) )
-                        {
-                            types_values.reserve( nb_cells );
-                            for( const auto type :
-                                this->template read_integer_data_array<
-                                    int32_t >( data ) )
-                            {
-                                types_values.push_back(
-                                    static_cast< uint8_t >( type ) );
-                            }
-                        }
-                        else
-                        {
-                            throw OpenGeodeIOMeshException{ nullptr,
-                                OpenGeodeException::TYPE::data,
-                                "[VTUInputImpl::read_cells] Wrong types type" };
-                        }
-                        OpenGeodeIOMeshException::check_assertion(
-                            types_values.size() == nb_cells,
-                            "[VTUInputImpl::read_cells] Wrong number of "
-                            "types" );
+                            this->template read_data_array< index_t >( data );
                     }
                 }
-                return std::tuple{ this->get_cell_vertices(
-                                       connectivity_values, offsets_values ),
-                    types_values };
+                return this->get_cell_vertices(
+                    std::move( connectivity_values ),
+                    std::move( offsets_values ) );
+            }
+
+            /*!
+             * Cell types are decoded once per file piece: loadability checks
+             * and the following read share them.
+             */
+            VTKCellTypes read_cell_types(
+                const pugi::xml_node& piece, index_t nb_cells ) const
+            {
+                const auto piece_id = piece_index( piece );
+                const auto data = types_data_array( piece );
+                const auto encoded_types = this->encoded_values( data );
+                if( auto types = find_vtk_cell_types(
+                        this->filename(), piece_id, encoded_types ) )
+                {
+                    OpenGeodeIOMeshException::check_assertion(
+                        types->size() == nb_cells,
+                        "[VTUInputImpl::read_cell_types] Wrong number of "
+                        "types" );
+                    return types;
+                }
+                auto types = std::make_shared< const std::vector< uint8_t > >(
+                    decode_cell_types( data, nb_cells ) );
+                store_vtk_cell_types(
+                    this->filename(), piece_id, encoded_types, types );
+                return types;
+            }
+
+        private:
+            static index_t piece_index( const pugi::xml_node& piece )
+            {
+                index_t index{ 0 };
+                for( auto previous = piece.previous_sibling( "Piece" );
+                     previous; previous = previous.previous_sibling( "Piece" ) )
+                {
+                    index++;
+                }
+                return index;
+            }
+
+            static pugi::xml_node types_data_array(
+                const pugi::xml_node& piece )
+            {
+                const auto data =
+                    piece.child( "Cells" ).find_child_by_attribute(
+                        "DataArray", "Name", "types" );
+                OpenGeodeIOMeshException::check_exception( data, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTUInputImpl::types_data_array] Missing types "
+                    "DataArray" );
+                return data;
+            }
+
+            std::vector< uint8_t > decode_cell_types(
+                const pugi::xml_node& data, index_t nb_cells ) const
+            {
+                auto types_values =
+                    this->template read_data_array< uint8_t >( data );
+                OpenGeodeIOMeshException::check_assertion(
+                    types_values.size() == nb_cells,
+                    "[VTUInputImpl::decode_cell_types] Wrong number of "
+                    "types" );
+                return types_values;
             }
         };
     } // namespace detail
@@ -23,9 +23,18 @@
 
 #pragma once
 
-#include <geode/io/mesh/detail/vtk_mesh_output.hpp>
+#include <filesystem>
+
+#include <async++.h>
 
-#include <absl/strings/str_split.h>
+#include <absl/algorithm/container.h>
+#include <absl/container/fixed_array.h>
+
+#include <geode/basic/filename.hpp>
+
+#include <geode/io/mesh/detail/vtk_adjacency.hpp>
+#include <geode/io/mesh/detail/vtk_mesh_output.hpp>
+#include <geode/io/mesh/detail/vtk_partition.hpp>
 
 namespace geode
 {
@@ -35,6 +44,7 @@ namespace geode
         static constexpr auto VTK_HEXAHEDRON_TYPE = 12u;
         static constexpr auto VTK_PRISM_TYPE = 13u;
         static constexpr auto VTK_PYRAMID_TYPE = 14u;
+        static constexpr auto VTK_POLYHEDRON_TYPE = 42u;
         static constexpr std::array< geode::index_t, 9 >
             VTK_NB_VERTICES_TO_CELL_TYPE{ 0, 0, 0, 0, VTK_TETRAHEDRON_TYPE,
                 VTK_PYRAMID_TYPE, VTK_PRISM_TYPE, 0, VTK_HEXAHEDRON_TYPE };
@@ -45,119 +55,271 @@ namespace geode
         protected:
             VTUOutputImpl( std::string_view filename, const Mesh< 3 >& solid )
                 : VTKMeshOutputImpl< Mesh, 3 >(
-                      filename, solid, "UnstructuredGrid" )
+                      filename, solid, "UnstructuredGrid" ),
+                  polyhedra_( solid.nb_polyhedra() )
+            {
+                absl::c_iota( polyhedra_, 0 );
+            }
+
+            /*!
+             * Output of a piece of the solid, made of the given polyhedra
+             * and of their vertices only
+             */
+            VTUOutputImpl( std::string_view filename,
+                const Mesh< 3 >& solid,
+                std::vector< index_t > polyhedra )
+                : VTKMeshOutputImpl< Mesh, 3 >(
+                      filename, solid, "UnstructuredGrid" ),
+                  polyhedra_( std::move( polyhedra ) ),
+                  vertex_mapping_( solid.nb_vertices(), NO_ID )
             {
             }
 
+            /*!
+             * Index of a solid vertex in the written file
+             */
+            index_t output_vertex( index_t vertex ) const
+            {
+                return vertex_mapping_.empty() ? vertex
+                                               : vertex_mapping_[vertex];
+            }
+
         private:
-            void append_number_elements( pugi::xml_node& piece ) override
+            std::vector< index_t > compute_vertices() override
+            {
+                if( vertex_mapping_.empty() )
+                {
+                    return VTKMeshOutputImpl< Mesh, 3 >::compute_vertices();
+                }
+                std::vector< index_t > vertices;
+                for( const auto p : polyhedra_ )
+                {
+                    for( const auto v :
+                        LRange{ this->mesh().nb_polyhedron_vertices( p ) } )
+                    {
+                        const auto vertex =
+                            this->mesh().polyhedron_vertex( { p, v } );
+                        if( vertex_mapping_[vertex] == NO_ID )
+                        {
+                            vertex_mapping_[vertex] = vertices.size();
+                            vertices.push_back( vertex );
+                        }
+                    }
+                }
+                return vertices;
+            }
+
+            void append_number_elements() override
             {
-                piece.append_attribute( "NumberOfCells" )
-                    .set_value( this->mesh().nb_polyhedra() );
+                this->xml().add_attribute( "NumberOfCells", polyhedra_.size() );
             }
 
-            pugi::xml_node write_vtk_cells( pugi::xml_node& piece ) override
+            /*!
+             * Vertices of a piece are identified by their solid vertex, for
+             * vertices shared by several pieces to be merged when read
+             */
+            void write_vtk_global_ids(
+                absl::Span< const index_t > vertices ) override
             {
-                const auto nb_cells = this->mesh().nb_polyhedra();
-                std::string cell_connectivity;
+                if( vertex_mapping_.empty() )
+                {
+                    return;
+                }
+                this->xml().add_attribute( "GlobalIds", VTK_GLOBAL_IDS_ARRAY );
+                const std::vector< int64_t > global_ids(
+                    vertices.begin(), vertices.end() );
+                this->write_index_data_array(
+                    VTK_GLOBAL_IDS_ARRAY, global_ids );
+            }
+
+            void write_vtk_cells() override
+            {
+                const auto nb_cells = polyhedra_.size();
+                std::vector< int64_t > cell_connectivity;
                 cell_connectivity.reserve( nb_cells * 4 );
-                std::string cell_offsets;
+                std::vector< int64_t > cell_offsets;
                 cell_offsets.reserve( nb_cells );
-                std::string cell_types;
+                std::vector< uint8_t > cell_types;
                 cell_types.reserve( nb_cells );
-                std::string cell_faces;
-                cell_faces.reserve( nb_cells * 4 );
-                std::string cell_face_offsets;
-                cell_face_offsets.reserve( nb_cells );
+                std::vector< int64_t > cell_faces;
+                std::vector< int64_t > cell_face_offsets;
                 index_t vertex_offset{ 0 };
                 index_t face_offset{ 0 };
-                for( const auto p : Range{ nb_cells } )
+                for( const auto p : polyhedra_ )
                 {
                     const auto nb_vertices =
                         this->mesh().nb_polyhedron_vertices( p );
                     vertex_offset += nb_vertices;
-                    absl::StrAppend( &cell_offsets, vertex_offset, " " );
+                    cell_offsets.push_back( vertex_offset );
                     for( const auto v : LRange{ nb_vertices } )
                     {
-                        absl::StrAppend( &cell_connectivity,
-                            this->mesh().polyhedron_vertex( { p, v } ), " " );
+                        cell_connectivity.push_back( output_vertex(
+                            this->mesh().polyhedron_vertex( { p, v } ) ) );
                     }
                     write_cell( p, cell_types, cell_faces, cell_face_offsets,
                         face_offset );
                 }
 
-                const auto nb_vertices = this->mesh().nb_vertices();
-                auto cells = piece.append_child( "Cells" );
-                auto connectivity = cells.append_child( "DataArray" );
-                connectivity.append_attribute( "type" ).set_value( "Int64" );
-                connectivity.append_attribute( "Name" ).set_value(
-                    "connectivity" );
-                connectivity.append_attribute( "format" ).set_value( "ascii" );
-                connectivity.append_attribute( "RangeMin" ).set_value( 0 );
-                connectivity.append_attribute( "RangeMax" )
-                    .set_value( nb_vertices - 1 );
-                connectivity.text().set( cell_connectivity.c_str() );
-
-                auto offsets = cells.append_child( "DataArray" );
-                offsets.append_attribute( "type" ).set_value( "Int64" );
-                offsets.append_attribute( "Name" ).set_value( "offsets" );
-                offsets.append_attribute( "format" ).set_value( "ascii" );
-                offsets.append_attribute( "RangeMin" ).set_value( 0 );
-                offsets.append_attribute( "RangeMax" ).set_value( nb_vertices );
-                offsets.text().set( cell_offsets.c_str() );
-
-                auto types = cells.append_child( "DataArray" );
-                types.append_attribute( "type" ).set_value( "UInt8" );
-                types.append_attribute( "Name" ).set_value( "types" );
-                types.append_attribute( "format" ).set_value( "ascii" );
-                types.append_attribute( "RangeMin" ).set_value( 1 );
-                types.append_attribute( "RangeMax" ).set_value( 42 );
-                types.text().set( cell_types.c_str() );
+                auto& xml = this->xml();
+                xml.start_element( "Cells" );
+                this->write_index_data_array(
+                    "connectivity", cell_connectivity );
 
-                if( !cell_faces.empty() )
+                this->write_index_data_array( "offsets", cell_offsets );
+
+                this->start_data_array( "UInt8", "types" );
+                if( !cell_types.empty() )
                 {
-                    auto faces = cells.append_child( "DataArray" );
-                    faces.append_attribute( "type" ).set_value( "Int64" );
-                    faces.append_attribute( "Name" ).set_value( "faces" );
-                    faces.append_attribute( "format" ).set_value( "ascii" );
-                    faces.append_attribute( "RangeMin" ).set_value( 0 );
-                    faces.append_attribute( "RangeMax" )
-                        .set_value( nb_vertices );
-                    faces.text().set( cell_faces.c_str() );
+                    const auto range = absl::c_minmax_element( cell_types );
+                    xml.add_attribute(
+                        "RangeMin", static_cast< int >( *range.first ) );
+                    xml.add_attribute(
+                        "RangeMax", static_cast< int >( *range.second ) );
                 }
-                if( !cell_face_offsets.empty() )
+                this->template write_data_array< uint8_t >( cell_types );
+
+                if( !cell_faces.empty() )
                 {
-                    auto face_offsets = cells.append_child( "DataArray" );
-                    face_offsets.append_attribute( "type" ).set_value(
-                        "Int64" );
-                    face_offsets.append_attribute( "Name" ).set_value(
-                        "faceoffsets" );
-                    face_offsets.append_attribute( "format" )
-                        .set_value( "ascii" );
-                    face_offsets.append_attribute( "RangeMin" ).set_value( -1 );
-                    const std::vector< std::string_view > tokens =
-                        absl::StrSplit( cell_faces, " " );
-                    face_offsets.append_attribute( "RangeMax" )
-                        .set_value( tokens.size() );
-                    face_offsets.text().set( cell_face_offsets.c_str() );
+                    write_polyhedron_faces( cell_faces, cell_face_offsets );
                 }
-                return cells;
+                xml.end_element();
             }
 
             virtual void write_cell( index_t c,
-                std::string& cell_types,
-                std::string& cell_faces,
-                std::string& cell_face_offsets,
+                std::vector< uint8_t >& cell_types,
+                std::vector< int64_t >& cell_faces,
+                std::vector< int64_t >& cell_face_offsets,
                 index_t& face_offset ) const = 0;
 
-            pugi::xml_node write_vtk_cell_attributes(
-                pugi::xml_node& piece ) override
+            void write_vtk_cell_attributes() override
             {
-                auto cell_data = piece.append_child( "CellData" );
+                this->xml().start_element( "CellData" );
                 this->write_attributes(
-                    cell_data, this->mesh().polyhedron_attribute_manager() );
-                return cell_data;
+                    this->mesh().polyhedron_attribute_manager(), polyhedra_ );
+                // Adjacencies of a piece would refer to other pieces
+                if( this->options().adjacencies && vertex_mapping_.empty() )
+                {
+                    const auto adjacencies =
+                        vtk_polyhedron_adjacencies( this->mesh() );
+                    this->write_index_data_array( VTK_ADJACENCY_ARRAY,
+                        adjacencies.values, adjacencies.nb_components );
+                }
+                this->xml().end_element();
+            }
+
+        private:
+            /*!
+             * Write the faces of the polyhedra given as a legacy VTK face
+             * stream: for each cell with faces, its number of faces then
+             * the number of vertices and the vertices of each face. Cells
+             * without faces have a -1 face offset.
+             */
+            void write_polyhedron_faces( absl::Span< const int64_t > faces,
+                absl::Span< const int64_t > face_offsets )
+            {
+                if( this->options().polyhedron_faces
+                    == VTK_POLYHEDRON_FACES::legacy )
+                {
+                    this->write_index_data_array( "faces", faces );
+                    this->write_index_data_array(
+                        "faceoffsets", face_offsets );
+                    return;
+                }
+                // Each polyhedron lists its own faces, in sequence: a face
+                // shared by two polyhedra is written twice, once with the
+                // orientation of each one
+                std::vector< int64_t > face_connectivity;
+                std::vector< int64_t > face_ends;
+                std::vector< int64_t > polyhedron_to_faces;
+                std::vector< int64_t > polyhedron_ends;
+                polyhedron_ends.reserve( face_offsets.size() );
+                size_t position{ 0 };
+                for( const auto offset : face_offsets )
+                {
+                    if( offset >= 0 )
+                    {
+                        const auto nb_faces = faces[position++];
+                        for( int64_t f = 0; f < nb_faces; f++ )
+                        {
+                            const auto nb_vertices = faces[position++];
+                            face_connectivity.insert( face_connectivity.end(),
+                                faces.begin() + position,
+                                faces.begin() + position + nb_vertices );
+                            position += nb_vertices;
+                            polyhedron_to_faces.push_back( face_ends.size() );
+                            face_ends.push_back( face_connectivity.size() );
+                        }
+                    }
+                    polyhedron_ends.push_back( polyhedron_to_faces.size() );
+                }
+                this->write_index_data_array(
+                    "face_connectivity", face_connectivity );
+                this->write_index_data_array( "face_offsets", face_ends );
+                this->write_index_data_array(
+                    "polyhedron_to_faces", polyhedron_to_faces );
+                this->write_index_data_array(
+                    "polyhedron_offsets", polyhedron_ends );
             }
+
+        private:
+            std::vector< index_t > polyhedra_;
+            std::vector< index_t > vertex_mapping_;
         };
+
+        /*!
+         * Write a partitioned file (.pvtu) and its piece files, stored in a
+         * directory named after the file. The solid is split into
+         * spatially coherent pieces, written concurrently.
+         * @tparam PieceOutput VTUOutputImpl constructible from a piece
+         * filename, the solid and the piece polyhedra.
+         */
+        template < typename PieceOutput, typename Solid >
+        std::vector< std::string > write_pvtu_file(
+            std::string_view filename, const Solid& solid )
+        {
+            const auto nb_pieces = std::max( index_t{ 1 },
+                std::min( vtk_output_options().nb_pieces,
+                    solid.nb_polyhedra() ) );
+            std::vector< Point3D > barycenters( solid.nb_polyhedra() );
+            for( const auto p : Range{ solid.nb_polyhedra() } )
+            {
+                barycenters[p] = solid.polyhedron_barycenter( p );
+            }
+            auto pieces = partition_elements( barycenters, nb_pieces );
+            const auto files_directory =
+                filepath_without_extension( filename ).string();
+            const auto prefix = filename_without_extension( filename ).string();
+            std::filesystem::create_directories( files_directory );
+            std::vector< std::string > files{ to_string( filename ) };
+            std::vector< std::string > sources;
+            for( const auto p : Indices{ pieces } )
+            {
+                const auto piece_name = absl::StrCat( prefix, "_", p, ".vtu" );
+                sources.push_back( absl::StrCat( prefix, "/", piece_name ) );
+                files.push_back(
+                    absl::StrCat( files_directory, "/", piece_name ) );
+            }
+            absl::FixedArray< async::task< void > > tasks( pieces.size() );
+            for( const auto p : Indices{ pieces } )
+            {
+                tasks[p] = async::spawn( [&, p] {
+                    PieceOutput output{ files[p + 1], solid,
+                        std::move( pieces[p] ) };
+                    output.write_file();
+                    if( p == 0 )
+                    {
+                        // Arrays are declared from the first written piece
+                        output.write_partitioned_file( filename, sources );
+                    }
+                } );
+            }
+            auto all_tasks = async::when_all( tasks.begin(), tasks.end() );
+            all_tasks.wait();
+            for( auto& task : all_tasks.get() )
+            {
+                task.get();
+            }
+            return files;
+        }
     } // namespace detail
 } // namespace geode
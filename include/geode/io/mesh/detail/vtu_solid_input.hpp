@@ -23,6 +23,10 @@
 
 #pragma once
 
+#include <limits>
+
+#include <absl/algorithm/container.h>
+
 #include <geode/io/mesh/detail/vtu_input_impl.hpp>
 
 namespace geode
@@ -32,9 +36,9 @@ namespace geode
         template < typename Mesh >
         class VTUSolidInput : public VTUInputImpl< Mesh >
         {
+        protected:
             using VTKElement = absl::FixedArray< std::vector< local_index_t > >;
 
-        protected:
             VTUSolidInput(
                 std::string_view filename, const geode::MeshImpl& impl )
                 : VTUInputImpl< Mesh >( filename, impl ),
@@ -86,61 +90,347 @@ namespace geode
                 elements_.emplace( 14, vtk_pyramid_ );
             }
 
+            /*!
+             * Enable general polyhedra (VTK_POLYHEDRON), described by their
+             * faces
+             */
+            void enable_polyhedron()
+            {
+                polyhedron_enabled_ = true;
+            }
+
+            /*!
+             * Create the polyhedra of the cells [begin, end), a run of
+             * consecutive cells sharing the same VTK type.
+             * Cells are created one by one: only the tetrahedral input
+             * creates a whole run at once, the hybrid and polyhedral solid
+             * builders having no bulk creation.
+             */
+            virtual void create_polyhedra( const VTKCells& cells,
+                index_t begin,
+                index_t end,
+                const VTKElement& element )
+            {
+                for( const auto c : Range{ begin, end } )
+                {
+                    this->builder().create_polyhedron(
+                        cells.cell_vertices( c ), element );
+                }
+            }
+
+            /*!
+             * Create the general polyhedra of the cells [begin, end) from
+             * their faces. Cells without faces are skipped.
+             * Facets are filled from the face spans of the cells into
+             * containers reused from one cell to the next.
+             */
+            void create_general_polyhedra(
+                const VTKCells& cells, index_t begin, index_t end )
+            {
+                if( !cells.has_faces() )
+                {
+                    return;
+                }
+                std::vector< index_t > vertices;
+                std::vector< std::vector< local_index_t > > facets;
+                for( const auto c : Range{ begin, end } )
+                {
+                    const auto first_face = cells.cell_face_offsets[c];
+                    const auto nb_faces =
+                        cells.cell_face_offsets[c + 1] - first_face;
+                    if( nb_faces == 0 )
+                    {
+                        continue;
+                    }
+                    const auto cell_vertices = cells.cell_vertices( c );
+                    vertices.assign(
+                        cell_vertices.begin(), cell_vertices.end() );
+                    if( facets.size() < nb_faces )
+                    {
+                        facets.resize( nb_faces );
+                    }
+                    for( const auto f : Range{ nb_faces } )
+                    {
+                        auto& facet = facets[f];
+                        facet.clear();
+                        for( const auto vertex :
+                            cells.face_vertices( first_face + f ) )
+                        {
+                            facet.push_back(
+                                polyhedron_vertex( vertices, vertex ) );
+                        }
+                    }
+                    this->builder().create_polyhedron( vertices,
+                        absl::MakeConstSpan( facets ).first( nb_faces ) );
+                }
+            }
+
         private:
-            void read_vtk_cells( const pugi::xml_node& piece ) override
+            static constexpr uint8_t VTK_POLYHEDRON{ 42 };
+
+            /*!
+             * Local index of the vertex in the polyhedron vertices, added
+             * if the cell connectivity misses it
+             */
+            static local_index_t polyhedron_vertex(
+                std::vector< index_t >& vertices, index_t vertex )
             {
-                const auto nb_polyhedra =
-                    this->read_attribute( piece, "NumberOfCells" );
-                const auto polyhedron_offset =
-                    build_polyhedra( piece, nb_polyhedra );
-                this->builder().compute_polyhedron_adjacencies();
-                this->read_data( piece.child( "CellData" ), polyhedron_offset,
-                    this->mesh().polyhedron_attribute_manager() );
+                const auto it = absl::c_find( vertices, vertex );
+                const auto local = static_cast< size_t >(
+                    std::distance( vertices.begin(), it ) );
+                OpenGeodeIOMeshException::check_exception(
+                    local < std::numeric_limits< local_index_t >::max(),
+                    nullptr, OpenGeodeException::TYPE::data,
+                    "[VTUSolidInput::polyhedron_vertex] Too many vertices "
+                    "in a polyhedron" );
+                if( it == vertices.end() )
+                {
+                    vertices.push_back( vertex );
+                }
+                return static_cast< local_index_t >( local );
             }
 
-            Percentage is_vtk_cells_loadable(
+            VTKCells read_vtk_cells(
                 const pugi::xml_node& piece ) const override
             {
                 const auto nb_polyhedra =
                     this->read_attribute( piece, "NumberOfCells" );
-                const auto [_, types] = this->read_cells( piece, nb_polyhedra );
-                index_t nb_loadable_polyhedra{ 0 };
-                for( const auto& type : types )
+                auto cells = this->read_cell_vertices( piece, nb_polyhedra );
+                cells.types = this->read_cell_types( piece, nb_polyhedra );
+                if( polyhedron_enabled_
+                    && absl::c_linear_search( *cells.types, VTK_POLYHEDRON ) )
+                {
+                    read_polyhedron_faces( piece, cells );
+                }
+                return cells;
+            }
+
+            /*!
+             * Decode the cell faces into the flat CSR of the cells, from
+             * either the legacy layout (faces and faceoffsets arrays) or the
+             * VTK 9.4 layout (face_connectivity, face_offsets,
+             * polyhedron_to_faces and polyhedron_offsets arrays)
+             */
+            void read_polyhedron_faces(
+                const pugi::xml_node& piece, VTKCells& cells ) const
+            {
+                const auto cells_node = piece.child( "Cells" );
+                const auto data_array = [&cells_node]( const char* name ) {
+                    return cells_node.find_child_by_attribute(
+                        "DataArray", "Name", name );
+                };
+                cells.cell_face_offsets.reserve( cells.nb_cells() + 1 );
+                cells.cell_face_offsets.push_back( 0 );
+                cells.face_offsets.push_back( cells.vertices.size() );
+                if( const auto face_connectivity =
+                        data_array( "face_connectivity" ) )
+                {
+                    read_indexed_faces( face_connectivity,
+                        data_array( "face_offsets" ),
+                        data_array( "polyhedron_to_faces" ),
+                        data_array( "polyhedron_offsets" ), cells );
+                }
+                else if( const auto faces = data_array( "faces" ) )
+                {
+                    read_face_stream(
+                        faces, data_array( "faceoffsets" ), cells );
+                }
+                else
+                {
+                    cells.cell_face_offsets.clear();
+                    cells.face_offsets.clear();
+                }
+            }
+
+            void read_face_stream( const pugi::xml_node& faces_node,
+                const pugi::xml_node& face_offsets_node,
+                VTKCells& cells ) const
+            {
+                const auto faces =
+                    this->template read_data_array< index_t >( faces_node );
+                const auto face_offsets =
+                    this->template read_data_array< int64_t >(
+                        face_offsets_node );
+                OpenGeodeIOMeshException::check_exception(
+                    face_offsets.size() == cells.nb_cells(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTUSolidInput::read_face_stream] Wrong number of face "
+                    "offsets" );
+                // Streams of the cells with faces follow each other: they
+                // are decoded in sequence
+                size_t position{ 0 };
+                const auto next_value = [&faces, &position] {
+                    OpenGeodeIOMeshException::check_exception(
+                        position < faces.size(), nullptr,
+                        OpenGeodeException::TYPE::data,
+                        "[VTUSolidInput::read_face_stream] Truncated "
+                        "faces" );
+                    return faces[position++];
+                };
+                for( const auto offset : face_offsets )
                 {
-                    if( elements_.contains( type ) )
+                    if( offset >= 0 )
                     {
-                        nb_loadable_polyhedra++;
+                        const auto nb_faces = next_value();
+                        for( const auto f : Range{ nb_faces } )
+                        {
+                            geode_unused( f );
+                            const auto nb_vertices = next_value();
+                            for( const auto v : Range{ nb_vertices } )
+                            {
+                                geode_unused( v );
+                                cells.vertices.push_back( next_value() );
+                            }
+                            cells.face_offsets.push_back(
+                                cells.vertices.size() );
+                        }
                     }
+                    cells.cell_face_offsets.push_back(
+                        cells.face_offsets.size() - 1 );
                 }
-                return Percentage{ static_cast< double >(
-                                       nb_loadable_polyhedra )
-                                   / nb_polyhedra };
             }
 
-            index_t build_polyhedra(
-                const pugi::xml_node& piece, index_t nb_polyhedra )
+            void read_indexed_faces( const pugi::xml_node& connectivity_node,
+                const pugi::xml_node& face_offsets_node,
+                const pugi::xml_node& polyhedron_faces_node,
+                const pugi::xml_node& polyhedron_offsets_node,
+                VTKCells& cells ) const
+            {
+                const auto connectivity =
+                    this->template read_data_array< index_t >(
+                        connectivity_node );
+                auto face_ends = this->template read_data_array< index_t >(
+                    face_offsets_node );
+                const auto polyhedron_faces =
+                    this->template read_data_array< index_t >(
+                        polyhedron_faces_node );
+                auto polyhedron_ends =
+                    this->template read_data_array< index_t >(
+                        polyhedron_offsets_node );
+                // Offsets may start with a leading 0
+                if( !face_ends.empty() && face_ends.front() == 0 )
+                {
+                    face_ends.erase( face_ends.begin() );
+                }
+                if( polyhedron_ends.size() == cells.nb_cells() + 1 )
+                {
+                    polyhedron_ends.erase( polyhedron_ends.begin() );
+                }
+                OpenGeodeIOMeshException::check_exception(
+                    polyhedron_ends.size() == cells.nb_cells(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTUSolidInput::read_indexed_faces] Wrong number of "
+                    "polyhedron offsets" );
+                index_t polyhedron_begin{ 0 };
+                for( const auto polyhedron_end : polyhedron_ends )
+                {
+                    OpenGeodeIOMeshException::check_exception(
+                        polyhedron_begin <= polyhedron_end
+                            && polyhedron_end <= polyhedron_faces.size(),
+                        nullptr, OpenGeodeException::TYPE::data,
+                        "[VTUSolidInput::read_indexed_faces] Wrong "
+                        "polyhedron offsets" );
+                    for( const auto i :
+                        Range{ polyhedron_begin, polyhedron_end } )
+                    {
+                        const auto face = polyhedron_faces[i];
+                        OpenGeodeIOMeshException::check_exception(
+                            face < face_ends.size(), nullptr,
+                            OpenGeodeException::TYPE::data,
+                            "[VTUSolidInput::read_indexed_faces] Wrong "
+                            "face index" );
+                        const auto face_begin =
+                            face == 0 ? 0 : face_ends[face - 1];
+                        const auto face_end = face_ends[face];
+                        OpenGeodeIOMeshException::check_exception(
+                            face_begin <= face_end
+                                && face_end <= connectivity.size(),
+                            nullptr, OpenGeodeException::TYPE::data,
+                            "[VTUSolidInput::read_indexed_faces] Wrong "
+                            "face offsets" );
+                        cells.vertices.insert( cells.vertices.end(),
+                            connectivity.begin() + face_begin,
+                            connectivity.begin() + face_end );
+                        cells.face_offsets.push_back( cells.vertices.size() );
+                    }
+                    cells.cell_face_offsets.push_back(
+                        cells.face_offsets.size() - 1 );
+                    polyhedron_begin = polyhedron_end;
+                }
+            }
+
+            index_t build_vtk_cells( const VTKCells& cells ) override
             {
-                const auto [polyhedron_vertices, types] =
-                    this->read_cells( piece, nb_polyhedra );
                 const auto polyhedra_offset = this->mesh().nb_polyhedra();
-                for( const auto p : Indices{ polyhedron_vertices } )
+                const auto& types = *cells.types;
+                index_t begin{ 0 };
+                while( begin < cells.nb_cells() )
                 {
-                    const auto it = elements_.find( types[p] );
+                    const auto type = types[begin];
+                    auto end = begin + 1;
+                    while( end < cells.nb_cells() && types[end] == type )
+                    {
+                        end++;
+                    }
+                    const auto it = elements_.find( type );
                     if( it != elements_.end() )
                     {
-                        this->builder().create_polyhedron(
-                            polyhedron_vertices[p], it->second );
+                        create_polyhedra( cells, begin, end, it->second );
                     }
+                    else if( polyhedron_enabled_ && type == VTK_POLYHEDRON )
+                    {
+                        create_general_polyhedra( cells, begin, end );
+                    }
+                    begin = end;
                 }
                 return polyhedra_offset;
             }
 
+            AttributeManager& vtk_cell_attribute_manager() override
+            {
+                return this->mesh().polyhedron_attribute_manager();
+            }
+
+            void compute_vtk_cell_adjacencies() override
+            {
+                this->builder().compute_polyhedron_adjacencies();
+            }
+
+            bool set_vtk_cell_adjacencies(
+                absl::Span< const int64_t > adjacencies,
+                index_t nb_components ) override
+            {
+                return set_vtk_polyhedron_adjacencies( this->mesh(),
+                    this->builder(), adjacencies, nb_components );
+            }
+
+            Percentage is_vtk_cells_loadable(
+                const pugi::xml_node& piece ) const override
+            {
+                const auto nb_polyhedra =
+                    this->read_attribute( piece, "NumberOfCells" );
+                const auto types = this->read_cell_types( piece, nb_polyhedra );
+                index_t nb_loadable_polyhedra{ 0 };
+                for( const auto& type : *types )
+                {
+                    if( elements_.contains( type )
+                        || ( polyhedron_enabled_ && type == VTK_POLYHEDRON ) )
+                    {
+                        nb_loadable_polyhedra++;
+                    }
+                }
+                return Percentage{ static_cast< double >(
+                                       nb_loadable_polyhedra )
+                                   / nb_polyhedra };
+            }
+
         private:
             absl::flat_hash_map< int64_t, VTKElement > elements_;
             VTKElement vtk_tetrahedron_;
             VTKElement vtk_hexahedron_;
             VTKElement vtk_prism_;
             VTKElement vtk_pyramid_;
+            bool polyhedron_enabled_{ false };
         };
     } // namespace detail
 } // namespace geode
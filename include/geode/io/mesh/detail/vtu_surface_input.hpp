@@ -49,16 +49,79 @@ namespace geode
                 elements_.emplace( 9, 4 );
             }
 
+            /*!
+             * Create the polygons of the cells [begin, end), a run of
+             * consecutive cells sharing the same VTK type, skipping the
+             * cells without the given number of vertices.
+             * Cells are created one by one: only the triangulated input
+             * creates a whole run at once, the polygonal surface builder
+             * having no bulk creation.
+             */
+            virtual void create_polygons( const VTKCells& cells,
+                index_t begin,
+                index_t end,
+                local_index_t nb_vertices )
+            {
+                for( const auto c : Range{ begin, end } )
+                {
+                    if( cells.nb_cell_vertices( c ) == nb_vertices )
+                    {
+                        this->builder().create_polygon(
+                            cells.cell_vertices( c ) );
+                    }
+                }
+            }
+
         private:
-            void read_vtk_cells( const pugi::xml_node& piece ) override
+            VTKCells read_vtk_cells(
+                const pugi::xml_node& piece ) const override
             {
                 const auto nb_polygons =
                     this->read_attribute( piece, "NumberOfCells" );
-                const auto polygon_offset =
-                    build_polygons( piece, nb_polygons );
+                auto cells = this->read_cell_vertices( piece, nb_polygons );
+                cells.types = this->read_cell_types( piece, nb_polygons );
+                return cells;
+            }
+
+            index_t build_vtk_cells( const VTKCells& cells ) override
+            {
+                const auto polygons_offset = this->mesh().nb_polygons();
+                const auto& types = *cells.types;
+                index_t begin{ 0 };
+                while( begin < cells.nb_cells() )
+                {
+                    const auto type = types[begin];
+                    auto end = begin + 1;
+                    while( end < cells.nb_cells() && types[end] == type )
+                    {
+                        end++;
+                    }
+                    const auto it = elements_.find( type );
+                    if( it != elements_.end() )
+                    {
+                        create_polygons( cells, begin, end, it->second );
+                    }
+                    begin = end;
+                }
+                return polygons_offset;
+            }
+
+            AttributeManager& vtk_cell_attribute_manager() override
+            {
+                return this->mesh().polygon_attribute_manager();
+            }
+
+            void compute_vtk_cell_adjacencies() override
+            {
                 this->builder().compute_polygon_adjacencies();
-                this->read_data( piece.child( "CellData" ), polygon_offset,
-                    this->mesh().polygon_attribute_manager() );
+            }
+
+            bool set_vtk_cell_adjacencies(
+                absl::Span< const int64_t > adjacencies,
+                index_t nb_components ) override
+            {
+                return set_vtk_polygon_adjacencies< 3 >( this->mesh(),
+                    this->builder(), adjacencies, nb_components );
             }
 
             Percentage is_vtk_cells_loadable(
@@ -66,9 +129,9 @@ namespace geode
             {
                 const auto nb_polygons =
                     this->read_attribute( piece, "NumberOfCells" );
-                const auto [_, types] = this->read_cells( piece, nb_polygons );
+                const auto types = this->read_cell_types( piece, nb_polygons );
                 index_t nb_loadable_polygons{ 0 };
-                for( const auto& type : types )
+                for( const auto& type : *types )
                 {
                     if( elements_.contains( type ) )
                     {
@@ -79,24 +142,6 @@ namespace geode
                                    / nb_polygons };
             }
 
-            index_t build_polygons(
-                const pugi::xml_node& piece, index_t nb_polygons )
-            {
-                const auto [polygon_vertices, types] =
-                    this->read_cells( piece, nb_polygons );
-                const auto polygons_offset = this->mesh().nb_polygons();
-                for( const auto p : Indices{ polygon_vertices } )
-                {
-                    const auto it = elements_.find( types[p] );
-                    if( it != elements_.end()
-                        && it->second == polygon_vertices[p].size() )
-                    {
-                        this->builder().create_polygon( polygon_vertices[p] );
-                    }
-                }
-                return polygons_offset;
-            }
-
         private:
             absl::flat_hash_map< int64_t, local_index_t > elements_;
         };
@@ -49,6 +49,12 @@ namespace geode
                 return EXT;
             }
 
+            static std::string_view partitioned_extension()
+            {
+                static constexpr auto EXT = "pvtu";
+                return EXT;
+            }
+
             std::unique_ptr< TetrahedralSolid3D > read(
                 const MeshImpl& impl ) final;
 
@@ -52,6 +52,12 @@ namespace geode
                 return EXT;
             }
 
+            static std::string_view partitioned_extension()
+            {
+                static constexpr auto EXT = "pvtu";
+                return EXT;
+            }
+
             std::vector< std::string > write(
                 const TetrahedralSolid3D &solid ) const final;
         };
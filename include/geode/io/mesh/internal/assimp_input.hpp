@@ -30,6 +30,7 @@
 #include <geode/basic/percentage.hpp>
 
 #include <geode/io/mesh/common.hpp>
+#include <geode/io/mesh/mesh_input_options.hpp>
 
 namespace geode
 {
@@ -40,7 +41,10 @@ namespace geode
         {
         public:
             explicit AssimpMeshInput( std::string_view filename )
-                : file_( filename )
+                : file_( filename ),
+                  compute_adjacencies_{
+                      mesh_input_options().compute_adjacencies
+                  }
             {
                 OpenGeodeIOMeshException::check_exception(
                     std::ifstream{ to_string( file_ ) }.good(), nullptr,
@@ -67,6 +71,7 @@ namespace geode
             std::vector< std::unique_ptr< Mesh > > surfaces_;
             std::string_view file_;
             std::vector< std::pair< std::string, std::string > > materials_;
+            bool compute_adjacencies_;
         };
     } // namespace internal
 } // namespace geode
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <geode/io/mesh/common.hpp>
+
+namespace geode
+{
+    struct MeshInputOptions
+    {
+        /*!
+         * Compute the element adjacencies (polygon, polyhedron) of the
+         * loaded meshes. Disable it when adjacencies are never used (e.g.
+         * format conversion, attribute extraction): they may then be
+         * computed afterwards with the compute_polygon_adjacencies() or
+         * compute_polyhedron_adjacencies() builder methods.
+         * Until then, adjacencies are left to NO_ID, even those stored in
+         * the file (e.g. by the VTK outputs): adjacency queries find no
+         * adjacent element, as if every element was on the border, and
+         * algorithms relying on them give wrong results.
+         */
+        bool compute_adjacencies{ true };
+    };
+
+    /*!
+     * Set the options used by the mesh and model inputs of OpenGeode-IO.
+     * Options are global, as inputs are only built from a filename: they
+     * are copied when an input starts, so inputs running on other threads
+     * may use either the previous or the new options.
+     */
+    void opengeode_io_mesh_api set_mesh_input_options(
+        const MeshInputOptions& options );
+
+    [[nodiscard]] MeshInputOptions opengeode_io_mesh_api mesh_input_options();
+} // namespace geode
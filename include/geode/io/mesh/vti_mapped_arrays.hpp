@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <geode/basic/pimpl.hpp>
+
+#include <geode/io/mesh/common.hpp>
+#include <geode/io/mesh/vtk_data_arrays.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( RegularGrid );
+} // namespace geode
+
+namespace geode
+{
+    /*!
+     * Read-only access to the PointData and CellData arrays of a .vti file
+     * stored in a raw AppendedData section, without loading them in
+     * memory. Values are read on demand, value e of an array being the
+     * value of the grid vertex or grid cell of index e:
+     * - uncompressed arrays are read in place from the memory mapped file,
+     * whose pages are loaded by the system when accessed;
+     * - compressed arrays are decompressed by blocks, each block being a
+     * slab of consecutive grid elements. Decompressed blocks are kept in a
+     * cache of bounded size, the least recently used ones being evicted
+     * first.
+     * Values may be accessed concurrently.
+     * @see load_mapped_regular_grid to load the grid along with its view.
+     */
+    class opengeode_io_mesh_api VTIMappedArrays
+    {
+    public:
+        static constexpr size_t DEFAULT_CACHE_SIZE{ 256 * 1024 * 1024 };
+
+        /*!
+         * @param[in] cache_size Maximal number of bytes of decompressed
+         * blocks kept in the cache. The last accessed block is always kept.
+         * @exception OpenGeodeException if the file is not a .vti file made
+         * of a single piece.
+         */
+        explicit VTIMappedArrays( std::string_view filename,
+            size_t cache_size = DEFAULT_CACHE_SIZE );
+        ~VTIMappedArrays();
+
+        /*!
+         * Arrays accessible on demand. Other arrays (inline or base64
+         * encoded) should be loaded with the grid.
+         */
+        [[nodiscard]] const std::vector< VTKDataArrayInfo >& arrays() const;
+
+        /*!
+         * Index of the array of the given location (PointData or
+         * CellData) and name in arrays(), or NO_ID if it is not accessible
+         * on demand
+         */
+        [[nodiscard]] index_t array_index(
+            std::string_view location, std::string_view name ) const;
+
+        /*!
+         * Number of elements (tuples) of the array
+         */
+        [[nodiscard]] index_t nb_elements( index_t array ) const;
+
+        /*!
+         * Value of a component of an array element, converted to double
+         */
+        [[nodiscard]] double value( index_t array,
+            index_t element,
+            local_index_t component = 0 ) const;
+
+    private:
+        IMPLEMENTATION_MEMBER( impl_ );
+    };
+
+    /*!
+     * RegularGrid whose raw appended arrays are accessed through the owned
+     * view instead of attributes
+     */
+    template < index_t dimension >
+    struct MappedRegularGrid
+    {
+        std::unique_ptr< RegularGrid< dimension > > grid;
+        std::unique_ptr< VTIMappedArrays > arrays;
+    };
+
+    /*!
+     * Load a single piece .vti file without creating attributes for its
+     * raw appended PointData and CellData arrays: their values are read
+     * on demand through the returned view, which should be kept as long
+     * as they are used. Other arrays are loaded as attributes.
+     * @param[in] cache_size Maximal number of bytes of decompressed blocks
+     * kept by the view.
+     * @exception OpenGeodeException if the file is not a .vti file made of
+     * a single piece.
+     */
+    template < index_t dimension >
+    [[nodiscard]] MappedRegularGrid< dimension > load_mapped_regular_grid(
+        std::string_view filename,
+        size_t cache_size = VTIMappedArrays::DEFAULT_CACHE_SIZE );
+} // namespace geode
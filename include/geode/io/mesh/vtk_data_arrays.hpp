@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <geode/io/mesh/common.hpp>
+
+namespace geode
+{
+    struct VTKDataArrayInfo
+    {
+        std::string name;
+        /*! VTK value type, e.g. Float64, Int32 or UInt8 */
+        std::string type;
+        index_t nb_components{ 1 };
+        /*! Either PointData or CellData */
+        std::string location;
+    };
+
+    /*!
+     * List the PointData and CellData arrays of a VTK XML file (.vtu, .vtp,
+     * .vti, or their partitioned versions) without decoding any of their
+     * values. Arrays are listed once even if they appear in several pieces.
+     */
+    [[nodiscard]] std::vector< VTKDataArrayInfo >
+        opengeode_io_mesh_api vtk_data_arrays( std::string_view filename );
+} // namespace geode
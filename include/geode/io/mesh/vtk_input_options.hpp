@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <string_view>
+
+#include <geode/io/mesh/common.hpp>
+
+namespace geode
+{
+    struct VTKInputOptions
+    {
+        /*!
+         * Attribute filter applied on PointData and CellData arrays using
+         * their names: rejected arrays are neither decoded nor created as
+         * attributes. Every array is loaded when no filter is given.
+         */
+        std::function< bool( std::string_view ) > attribute_filter;
+
+        /*!
+         * Decode the pieces of multi-piece files concurrently before merging
+         * them in file order. Decoded pieces are all kept in memory until
+         * they are merged: disable it to read pieces one by one.
+         */
+        bool parallel_pieces{ true };
+    };
+
+    /*!
+     * Set the options used by the VTK XML inputs (.vtu, .vtp, .vti).
+     * Options are copied when an input starts, so inputs running on other
+     * threads may use either the previous or the new options.
+     */
+    void opengeode_io_mesh_api set_vtk_input_options(
+        const VTKInputOptions& options );
+
+    [[nodiscard]] VTKInputOptions opengeode_io_mesh_api vtk_input_options();
+} // namespace geode
@@ -89,26 +89,47 @@ namespace geode
             }
 
         protected:
-            index_t write_corners_lines_surfaces( pugi::xml_node& object )
+            index_t write_corners_lines_surfaces()
             {
                 index_t counter{ 0 };
-                auto corner_block = object.append_child( "Block" );
-                corner_block.append_attribute( "name" ).set_value( "corners" );
-                corner_block.append_attribute( "index" ).set_value( counter++ );
-                write_corners( corner_block );
-                auto line_block = object.append_child( "Block" );
-                line_block.append_attribute( "name" ).set_value( "lines" );
-                line_block.append_attribute( "index" ).set_value( counter++ );
-                write_lines( line_block );
-                auto surface_block = object.append_child( "Block" );
-                surface_block.append_attribute( "name" ).set_value(
-                    "surfaces" );
-                surface_block.append_attribute( "index" ).set_value(
-                    counter++ );
-                write_surfaces( surface_block );
+                start_block( "corners", counter++ );
+                write_corners();
+                this->xml().end_element();
+                start_block( "lines", counter++ );
+                write_lines();
+                this->xml().end_element();
+                start_block( "surfaces", counter++ );
+                write_surfaces();
+                this->xml().end_element();
                 return counter;
             }
 
+            void start_block( std::string_view name, index_t index )
+            {
+                auto& xml = this->xml();
+                xml.start_element( "Block" );
+                xml.add_attribute( "name", name );
+                xml.add_attribute( "index", index );
+            }
+
+            /*!
+             * Write a DataSet element of the current Block, referencing the
+             * file of a component
+             */
+            void write_dataset( index_t index,
+                std::string_view name,
+                const uuid& id,
+                std::string_view file )
+            {
+                auto& xml = this->xml();
+                xml.start_element( "DataSet" );
+                xml.add_attribute( "index", index );
+                xml.add_attribute( "name", name );
+                xml.add_attribute( "uuid", id.string() );
+                xml.add_attribute( "file", file );
+                xml.end_element();
+            }
+
             std::string_view prefix() const
             {
                 return prefix_;
@@ -125,7 +146,7 @@ namespace geode
             }
 
         private:
-            void write_corners( pugi::xml_node& corner_block )
+            void write_corners()
             {
                 index_t counter{ 0 };
                 const auto level = Logger::level();
@@ -144,28 +165,15 @@ namespace geode
                 for( const auto& id : corner_ids )
                 {
                     const auto& corner = this->mesh().corner( id );
-                    auto dataset = corner_block.append_child( "DataSet" );
-                    dataset.append_attribute( "index" ).set_value( counter );
                     const auto name =
                         corner.name().value_or( corner.id().string() );
                     const auto [_, is_new] =
                         corner_name_counter.emplace( name );
-                    if( is_new )
-                    {
-                        dataset.append_attribute( "name" ).set_value(
-                            name.c_str() );
-                    }
-                    else
-                    {
-                        dataset.append_attribute( "name" ).set_value(
-                            absl::StrCat( name, "_", counter ).c_str() );
-                    }
-                    dataset.append_attribute( "uuid" ).set_value(
-                        corner.id().string().c_str() );
-                    const auto filename = absl::StrCat(
-                        prefix_, "/Corner_", corner.id().string(), ".vtp" );
-                    dataset.append_attribute( "file" ).set_value(
-                        filename.c_str() );
+                    write_dataset( counter,
+                        is_new ? name : absl::StrCat( name, "_", counter ),
+                        corner.id(),
+                        absl::StrCat( prefix_, "/Corner_",
+                            corner.id().string(), ".vtp" ) );
 
                     tasks[counter++] = async::spawn( [&corner, this] {
                         const auto& mesh = corner.mesh();
@@ -183,7 +191,7 @@ namespace geode
                 }
             }
 
-            void write_lines( pugi::xml_node& line_block )
+            void write_lines()
             {
                 index_t counter{ 0 };
                 const auto level = Logger::level();
@@ -201,27 +209,15 @@ namespace geode
                 for( const auto& id : line_ids )
                 {
                     const auto& line = this->mesh().line( id );
-                    auto dataset = line_block.append_child( "DataSet" );
-                    dataset.append_attribute( "index" ).set_value( counter );
                     const auto name =
                         line.name().value_or( line.id().string() );
-                    const auto [_, is_new] = line_name_counter.emplace( name );
-                    if( is_new )
-                    {
-                        dataset.append_attribute( "name" ).set_value(
-                            name.c_str() );
-                    }
-                    else
-                    {
-                        dataset.append_attribute( "name" ).set_value(
-                            absl::StrCat( name, "_", counter ).c_str() );
-                    }
-                    dataset.append_attribute( "uuid" ).set_value(
-                        line.id().string().c_str() );
-                    const auto filename = absl::StrCat(
-                        prefix_, "/Line_", line.id().string(), ".vtp" );
-                    dataset.append_attribute( "file" ).set_value(
-                        filename.c_str() );
+                    const auto [_, is_new] =
+                        line_name_counter.emplace( name );
+                    write_dataset( counter,
+                        is_new ? name : absl::StrCat( name, "_", counter ),
+                        line.id(),
+                        absl::StrCat( prefix_, "/Line_",
+                            line.id().string(), ".vtp" ) );
 
                     tasks[counter++] = async::spawn( [&line, this] {
                         const auto& mesh = line.mesh();
@@ -239,7 +235,7 @@ namespace geode
                 }
             }
 
-            void write_surfaces( pugi::xml_node& surface_block )
+            void write_surfaces()
             {
                 index_t counter{ 0 };
                 const auto level = Logger::level();
@@ -258,28 +254,15 @@ namespace geode
                 for( const auto& id : surface_ids )
                 {
                     const auto& surface = this->mesh().surface( id );
-                    auto dataset = surface_block.append_child( "DataSet" );
-                    dataset.append_attribute( "index" ).set_value( counter );
                     const auto name =
                         surface.name().value_or( surface.id().string() );
                     const auto [_, is_new] =
                         surface_name_counter.emplace( name );
-                    if( is_new )
-                    {
-                        dataset.append_attribute( "name" ).set_value(
-                            name.c_str() );
-                    }
-                    else
-                    {
-                        dataset.append_attribute( "name" ).set_value(
-                            absl::StrCat( name, "_", counter ).c_str() );
-                    }
-                    dataset.append_attribute( "uuid" ).set_value(
-                        surface.id().string().c_str() );
-                    const auto filename = absl::StrCat(
-                        prefix_, "/Surface_", surface.id().string(), ".vtp" );
-                    dataset.append_attribute( "file" ).set_value(
-                        filename.c_str() );
+                    write_dataset( counter,
+                        is_new ? name : absl::StrCat( name, "_", counter ),
+                        surface.id(),
+                        absl::StrCat( prefix_, "/Surface_",
+                            surface.id().string(), ".vtp" ) );
 
                     tasks[counter++] = async::spawn( [&surface, this] {
                         const auto& mesh = surface.mesh();
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/image/detail/base64.hpp>
+
+#include <array>
+#include <cstdint>
+
+#include <geode/basic/range.hpp>
+
+namespace
+{
+    constexpr std::string_view BASE64_CHARACTERS{
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+    };
+    constexpr uint8_t BASE64_WHITESPACE = 0x40;
+    constexpr uint8_t BASE64_INVALID = 0x80;
+    constexpr uint8_t BASE64_NOT_A_VALUE = BASE64_WHITESPACE | BASE64_INVALID;
+
+    constexpr std::array< uint8_t, 256 > base64_decoding_table()
+    {
+        std::array< uint8_t, 256 > table{};
+        for( auto& value : table )
+        {
+            value = BASE64_INVALID;
+        }
+        for( size_t i = 0; i < BASE64_CHARACTERS.size(); i++ )
+        {
+            table[static_cast< uint8_t >( BASE64_CHARACTERS[i] )] =
+                static_cast< uint8_t >( i );
+        }
+        for( const auto whitespace : { ' ', '\t', '\n', '\v', '\f', '\r' } )
+        {
+            table[static_cast< uint8_t >( whitespace )] = BASE64_WHITESPACE;
+        }
+        return table;
+    }
+
+    constexpr auto BASE64_DECODING_TABLE = base64_decoding_table();
+
+    size_t decode_base64_groups( const uint8_t* input,
+        size_t input_size,
+        uint8_t* output,
+        size_t output_size,
+        size_t& input_position )
+    {
+        size_t output_position{ 0 };
+        while( input_position + 4 <= input_size
+               && output_position + 3 <= output_size )
+        {
+            const auto* group = input + input_position;
+            const uint32_t v0 = BASE64_DECODING_TABLE[group[0]];
+            const uint32_t v1 = BASE64_DECODING_TABLE[group[1]];
+            const uint32_t v2 = BASE64_DECODING_TABLE[group[2]];
+            const uint32_t v3 = BASE64_DECODING_TABLE[group[3]];
+            if( ( v0 | v1 | v2 | v3 ) & BASE64_NOT_A_VALUE )
+            {
+                break;
+            }
+            const auto bits = ( v0 << 18 ) | ( v1 << 12 ) | ( v2 << 6 ) | v3;
+            output[output_position] = static_cast< uint8_t >( bits >> 16 );
+            output[output_position + 1] = static_cast< uint8_t >( bits >> 8 );
+            output[output_position + 2] = static_cast< uint8_t >( bits );
+            input_position += 4;
+            output_position += 3;
+        }
+        return output_position;
+    }
+} // namespace
+
+namespace geode
+{
+    namespace detail
+    {
+        size_t decode_base64(
+            std::string_view input, absl::Span< char > output )
+        {
+            const auto* input_bytes =
+                reinterpret_cast< const uint8_t* >( input.data() );
+            auto* output_bytes = reinterpret_cast< uint8_t* >( output.data() );
+            size_t input_position{ 0 };
+            size_t output_position{ 0 };
+            bool padding{ false };
+            while( input_position < input.size() && !padding )
+            {
+                output_position += decode_base64_groups( input_bytes,
+                    input.size(), output_bytes + output_position,
+                    output.size() - output_position, input_position );
+                // Slow path on a single group containing whitespace or
+                // padding, or on the last partial group
+                uint32_t bits{ 0 };
+                local_index_t nb_values{ 0 };
+                for( ; input_position < input.size() && nb_values < 4;
+                     input_position++ )
+                {
+                    const auto character = input_bytes[input_position];
+                    if( character == '=' )
+                    {
+                        padding = true;
+                        break;
+                    }
+                    const auto value = BASE64_DECODING_TABLE[character];
+                    if( value == BASE64_WHITESPACE )
+                    {
+                        continue;
+                    }
+                    OpenGeodeIOImageException::check_exception(
+                        value != BASE64_INVALID, nullptr,
+                        OpenGeodeException::TYPE::data,
+                        "[decode_base64] Invalid base64 character" );
+                    bits = ( bits << 6 ) | value;
+                    nb_values++;
+                }
+                if( nb_values == 0 )
+                {
+                    continue;
+                }
+                OpenGeodeIOImageException::check_exception( nb_values > 1,
+                    nullptr, OpenGeodeException::TYPE::data,
+                    "[decode_base64] Truncated base64 data" );
+                const auto nb_decoded = nb_values - 1;
+                OpenGeodeIOImageException::check_exception(
+                    output_position + nb_decoded <= output.size(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[decode_base64] Output is too small for decoded data" );
+                bits <<= 6 * ( 4 - nb_values );
+                for( const auto b : LRange{ nb_decoded } )
+                {
+                    output_bytes[output_position++] =
+                        static_cast< uint8_t >( bits >> ( 16 - 8 * b ) );
+                }
+            }
+            return output_position;
+        }
+
+        void encode_base64( std::string_view bytes, std::string& output )
+        {
+            const auto* input =
+                reinterpret_cast< const uint8_t* >( bytes.data() );
+            const auto nb_bytes = bytes.size();
+            const auto start = output.size();
+            output.resize( start + base64_encoded_size( nb_bytes ) );
+            auto* encoded = output.data() + start;
+            size_t i{ 0 };
+            for( ; i + 3 <= nb_bytes; i += 3 )
+            {
+                const auto bits = ( static_cast< uint32_t >( input[i] ) << 16 )
+                                  | ( static_cast< uint32_t >( input[i + 1] )
+                                      << 8 )
+                                  | input[i + 2];
+                encoded[0] = BASE64_CHARACTERS[( bits >> 18 ) & 0x3F];
+                encoded[1] = BASE64_CHARACTERS[( bits >> 12 ) & 0x3F];
+                encoded[2] = BASE64_CHARACTERS[( bits >> 6 ) & 0x3F];
+                encoded[3] = BASE64_CHARACTERS[bits & 0x3F];
+                encoded += 4;
+            }
+            const auto remainder = nb_bytes - i;
+            if( remainder == 0 )
+            {
+                return;
+            }
+            auto bits = static_cast< uint32_t >( input[i] ) << 16;
+            if( remainder == 2 )
+            {
+                bits |= static_cast< uint32_t >( input[i + 1] ) << 8;
+            }
+            encoded[0] = BASE64_CHARACTERS[( bits >> 18 ) & 0x3F];
+            encoded[1] = BASE64_CHARACTERS[( bits >> 12 ) & 0x3F];
+            encoded[2] =
+                remainder == 2 ? BASE64_CHARACTERS[( bits >> 6 ) & 0x3F] : '=';
+            encoded[3] = '=';
+        }
+    } // namespace detail
+} // namespace geode
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/image/detail/text_writer.hpp>
+
+#include <algorithm>
+
+#include <geode/io/image/text_output_options.hpp>
+
+namespace
+{
+    template < typename T >
+    void append_floating_number(
+        std::string& output, T value, geode::local_index_t significant_digits )
+    {
+        // Enough for the longest general format of a double, including its
+        // sign, exponent and a precision capped to 17 digits
+        char buffer[32];
+        constexpr geode::local_index_t MAX_DIGITS{ 17 };
+        const auto result =
+            significant_digits == 0
+                ? std::to_chars( buffer, buffer + sizeof( buffer ), value )
+                : std::to_chars( buffer, buffer + sizeof( buffer ), value,
+                      std::chars_format::general,
+                      std::min( significant_digits, MAX_DIGITS ) );
+        output.append( buffer, result.ptr );
+    }
+} // namespace
+
+namespace geode
+{
+    namespace detail
+    {
+        void append_number( std::string& output,
+            double value,
+            local_index_t significant_digits )
+        {
+            append_floating_number( output, value, significant_digits );
+        }
+
+        void append_number( std::string& output,
+            float value,
+            local_index_t significant_digits )
+        {
+            append_floating_number( output, value, significant_digits );
+        }
+
+        TextWriter::TextWriter( std::ostream& stream )
+            : stream_( stream ),
+              significant_digits_{ text_output_options().significant_digits }
+        {
+            buffer_.reserve( CHUNK_SIZE + CHUNK_SIZE / 4 );
+        }
+
+        TextWriter::~TextWriter()
+        {
+            write_chunk();
+        }
+
+        void TextWriter::flush()
+        {
+            write_chunk();
+            stream_.flush();
+        }
+
+        void TextWriter::write_chunk()
+        {
+            stream_.write( buffer_.data(),
+                static_cast< std::streamsize >( buffer_.size() ) );
+            buffer_.clear();
+        }
+    } // namespace detail
+} // namespace geode
@@ -46,35 +46,32 @@ namespace
         }
 
     private:
-        void write_piece( pugi::xml_node& object ) final
+        std::array< geode::index_t, dimension > extent() const final
         {
-            auto piece = object.append_child( "Piece" );
             std::array< geode::index_t, dimension > extent;
             for( const auto d : geode::LRange{ dimension } )
             {
                 extent[d] = this->mesh().nb_cells_in_direction( d );
             }
-            this->write_image_header( piece, extent );
-            write_point_data( piece );
+            return extent;
         }
 
-        void write_point_data( pugi::xml_node& piece )
+        void write_piece_data() final
         {
-            auto point_data = piece.append_child( "PointData" );
-            point_data.append_attribute( "Scalars" ).set_value( "Color" );
-            auto data_array = point_data.append_child( "DataArray" );
-            data_array.append_attribute( "type" ).set_value( "UInt8" );
-            data_array.append_attribute( "Name" ).set_value( "Color" );
-            data_array.append_attribute( "format" ).set_value( "ascii" );
-            data_array.append_attribute( "NumberOfComponents" ).set_value( 3 );
+            auto& xml = this->xml();
+            xml.start_element( "PointData" );
+            xml.add_attribute( "Scalars", "Color" );
+            this->start_data_array( "UInt8", "Color", 3 );
             auto min = std::numeric_limits< geode::local_index_t >::max();
             auto max = std::numeric_limits< geode::local_index_t >::lowest();
-            std::string values;
+            std::vector< uint8_t > values;
+            values.reserve( 3 * this->mesh().nb_cells() );
             for( const auto c : geode::Range{ this->mesh().nb_cells() } )
             {
                 const auto& color = this->mesh().color( c );
-                absl::StrAppend( &values, color.red(), " ", color.green(), " ",
-                    color.blue(), " " );
+                values.push_back( color.red() );
+                values.push_back( color.green() );
+                values.push_back( color.blue() );
                 min = std::min(
                     min, std::min( color.red(),
                              std::min( color.green(), color.blue() ) ) );
@@ -82,9 +79,13 @@ namespace
                     max, std::max( color.red(),
                              std::max( color.green(), color.blue() ) ) );
             }
-            data_array.append_attribute( "RangeMin" ).set_value( min );
-            data_array.append_attribute( "RangeMax" ).set_value( max );
-            data_array.text().set( values.c_str() );
+            if( !values.empty() )
+            {
+                xml.add_attribute( "RangeMin", min );
+                xml.add_attribute( "RangeMax", max );
+            }
+            this->template write_data_array< uint8_t >( values );
+            xml.end_element();
         }
     };
 } // namespace
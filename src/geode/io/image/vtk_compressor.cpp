@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/image/detail/vtk_compressor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+#include <async++.h>
+
+#include <lz4.h>
+#include <lzma.h>
+#include <zlib.h>
+
+namespace
+{
+    constexpr std::string_view ZLIB_NAME{ "vtkZLibDataCompressor" };
+    constexpr std::string_view LZ4_NAME{ "vtkLZ4DataCompressor" };
+    constexpr std::string_view LZMA_NAME{ "vtkLZMADataCompressor" };
+    // Middle of the 0-9 presets, trading speed for ratio
+    constexpr uint32_t LZMA_PRESET{ 5 };
+
+    void check_decompression( bool success, geode::VTK_COMPRESSOR type )
+    {
+        geode::OpenGeodeIOImageException::check_exception( success, nullptr,
+            geode::OpenGeodeException::TYPE::data,
+            "[VTKCompressor::decompress_block] Error in ",
+            geode::detail::VTKCompressor{ type }.vtk_name(),
+            " decompressing data" );
+    }
+
+    void check_compression( bool success, geode::VTK_COMPRESSOR type )
+    {
+        geode::OpenGeodeIOImageException::check_exception( success, nullptr,
+            geode::OpenGeodeException::TYPE::internal,
+            "[VTKCompressor::compress_block] Error in ",
+            geode::detail::VTKCompressor{ type }.vtk_name(),
+            " compressing data" );
+    }
+
+    void zlib_decompress( std::string_view block, absl::Span< char > output )
+    {
+        auto decompressed_size = static_cast< uLongf >( output.size() );
+        const auto result =
+            uncompress( reinterpret_cast< Bytef* >( output.data() ),
+                &decompressed_size,
+                reinterpret_cast< const Bytef* >( block.data() ),
+                static_cast< uLong >( block.size() ) );
+        check_decompression(
+            result == Z_OK && decompressed_size == output.size(),
+            geode::VTK_COMPRESSOR::zlib );
+    }
+
+    void lz4_decompress( std::string_view block, absl::Span< char > output )
+    {
+        const auto decompressed_size = LZ4_decompress_safe( block.data(),
+            output.data(), static_cast< int >( block.size() ),
+            static_cast< int >( output.size() ) );
+        check_decompression(
+            decompressed_size >= 0
+                && static_cast< size_t >( decompressed_size ) == output.size(),
+            geode::VTK_COMPRESSOR::lz4 );
+    }
+
+    void lzma_decompress( std::string_view block, absl::Span< char > output )
+    {
+        auto memory_limit = UINT64_MAX;
+        size_t input_position{ 0 };
+        size_t output_position{ 0 };
+        const auto result = lzma_stream_buffer_decode( &memory_limit, 0,
+            nullptr, reinterpret_cast< const uint8_t* >( block.data() ),
+            &input_position, block.size(),
+            reinterpret_cast< uint8_t* >( output.data() ), &output_position,
+            output.size() );
+        check_decompression(
+            result == LZMA_OK && output_position == output.size(),
+            geode::VTK_COMPRESSOR::lzma );
+    }
+
+    size_t zlib_compress( std::string_view bytes, std::string& output )
+    {
+        const auto start = output.size();
+        auto compressed_size =
+            compressBound( static_cast< uLong >( bytes.size() ) );
+        output.resize( start + compressed_size );
+        const auto result =
+            compress( reinterpret_cast< Bytef* >( output.data() + start ),
+                &compressed_size,
+                reinterpret_cast< const Bytef* >( bytes.data() ),
+                static_cast< uLong >( bytes.size() ) );
+        check_compression( result == Z_OK, geode::VTK_COMPRESSOR::zlib );
+        output.resize( start + compressed_size );
+        return compressed_size;
+    }
+
+    size_t lz4_compress( std::string_view bytes, std::string& output )
+    {
+        const auto start = output.size();
+        const auto bound =
+            LZ4_compressBound( static_cast< int >( bytes.size() ) );
+        output.resize( start + static_cast< size_t >( bound ) );
+        const auto compressed_size = LZ4_compress_default( bytes.data(),
+            output.data() + start, static_cast< int >( bytes.size() ),
+            bound );
+        check_compression( compressed_size > 0, geode::VTK_COMPRESSOR::lz4 );
+        output.resize( start + static_cast< size_t >( compressed_size ) );
+        return static_cast< size_t >( compressed_size );
+    }
+
+    size_t lzma_compress( std::string_view bytes, std::string& output )
+    {
+        const auto start = output.size();
+        output.resize( start + lzma_stream_buffer_bound( bytes.size() ) );
+        size_t compressed_size{ 0 };
+        const auto result = lzma_easy_buffer_encode( LZMA_PRESET,
+            LZMA_CHECK_CRC64, nullptr,
+            reinterpret_cast< const uint8_t* >( bytes.data() ), bytes.size(),
+            reinterpret_cast< uint8_t* >( output.data() + start ),
+            &compressed_size, output.size() - start );
+        check_compression( result == LZMA_OK, geode::VTK_COMPRESSOR::lzma );
+        output.resize( start + compressed_size );
+        return compressed_size;
+    }
+} // namespace
+
+namespace geode
+{
+    namespace detail
+    {
+        VTKCompressor VTKCompressor::from_vtk_name( std::string_view name )
+        {
+            if( name.empty() )
+            {
+                return VTKCompressor{ VTK_COMPRESSOR::none };
+            }
+            for( const auto type : { VTK_COMPRESSOR::zlib,
+                     VTK_COMPRESSOR::lz4, VTK_COMPRESSOR::lzma } )
+            {
+                VTKCompressor compressor{ type };
+                if( name == compressor.vtk_name() )
+                {
+                    return compressor;
+                }
+            }
+            throw OpenGeodeIOImageException{ nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTKCompressor::from_vtk_name] Unsupported compressor ", name,
+                ". Only ", ZLIB_NAME, ", ", LZ4_NAME, " and ", LZMA_NAME,
+                " are supported" };
+        }
+
+        std::string_view VTKCompressor::vtk_name() const
+        {
+            switch( type_ )
+            {
+            case VTK_COMPRESSOR::zlib:
+                return ZLIB_NAME;
+            case VTK_COMPRESSOR::lz4:
+                return LZ4_NAME;
+            case VTK_COMPRESSOR::lzma:
+                return LZMA_NAME;
+            default:
+                return {};
+            }
+        }
+
+        void VTKCompressor::decompress_block(
+            std::string_view block, absl::Span< char > output ) const
+        {
+            switch( type_ )
+            {
+            case VTK_COMPRESSOR::zlib:
+                return zlib_decompress( block, output );
+            case VTK_COMPRESSOR::lz4:
+                return lz4_decompress( block, output );
+            case VTK_COMPRESSOR::lzma:
+                return lzma_decompress( block, output );
+            default:
+                check_decompression( block.size() == output.size(), type_ );
+                std::copy( block.begin(), block.end(), output.begin() );
+            }
+        }
+
+        size_t VTKCompressor::compress_block(
+            std::string_view bytes, std::string& output ) const
+        {
+            switch( type_ )
+            {
+            case VTK_COMPRESSOR::zlib:
+                return zlib_compress( bytes, output );
+            case VTK_COMPRESSOR::lz4:
+                return lz4_compress( bytes, output );
+            case VTK_COMPRESSOR::lzma:
+                return lzma_compress( bytes, output );
+            default:
+                output.append( bytes.data(), bytes.size() );
+                return bytes.size();
+            }
+        }
+
+        std::vector< size_t > VTKCompressor::compress_blocks(
+            std::string_view bytes,
+            size_t block_size,
+            std::string& output ) const
+        {
+            OpenGeodeIOImageException::check_exception( block_size > 0,
+                nullptr, OpenGeodeException::TYPE::internal,
+                "[VTKCompressor::compress_blocks] Block size should not be "
+                "null" );
+            const auto nb_blocks =
+                ( bytes.size() + block_size - 1 ) / block_size;
+            std::vector< std::string > blocks( nb_blocks );
+            async::parallel_for( async::irange( size_t{ 0 }, nb_blocks ),
+                [&]( size_t b ) {
+                    compress_block(
+                        bytes.substr( b * block_size, block_size ), blocks[b] );
+                } );
+            std::vector< size_t > blocks_size;
+            blocks_size.reserve( nb_blocks );
+            for( const auto& block : blocks )
+            {
+                output.append( block );
+                blocks_size.push_back( block.size() );
+            }
+            return blocks_size;
+        }
+    } // namespace detail
+} // namespace geode
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/image/detail/vtk_xml_writer.hpp>
+
+#include <geode/io/image/detail/text_writer.hpp>
+
+namespace
+{
+    void write_escaped( std::ostream& stream, std::string_view value )
+    {
+        for( const auto character : value )
+        {
+            switch( character )
+            {
+            case '&':
+                stream << "&amp;";
+                break;
+            case '<':
+                stream << "&lt;";
+                break;
+            case '>':
+                stream << "&gt;";
+                break;
+            case '"':
+                stream << "&quot;";
+                break;
+            default:
+                stream.put( character );
+            }
+        }
+    }
+} // namespace
+
+namespace geode
+{
+    namespace detail
+    {
+        VTKXMLWriter::VTKXMLWriter( std::ostream& stream ) : stream_( stream )
+        {
+            stream_ << "<?xml version=\"1.0\"?>\n";
+        }
+
+        void VTKXMLWriter::start_element( std::string_view name )
+        {
+            close_start_tag();
+            indent( elements_.size() );
+            stream_ << '<' << name;
+            elements_.emplace_back( name );
+            start_tag_open_ = true;
+            has_text_ = false;
+        }
+
+        void VTKXMLWriter::add_attribute(
+            std::string_view name, std::string_view value )
+        {
+            OpenGeodeIOImageException::check_exception( start_tag_open_,
+                nullptr, OpenGeodeException::TYPE::internal,
+                "[VTKXMLWriter::add_attribute] Attribute ", name,
+                " added after the content of its element" );
+            stream_ << ' ' << name << "=\"";
+            write_escaped( stream_, value );
+            stream_ << '"';
+        }
+
+        void VTKXMLWriter::add_attribute( std::string_view name, double value )
+        {
+            // Shortest text read back as the exact same value
+            std::string text;
+            append_number( text, value, 0 );
+            add_attribute( name, text );
+        }
+
+        void VTKXMLWriter::add_attribute( std::string_view name, float value )
+        {
+            std::string text;
+            append_number( text, value, 0 );
+            add_attribute( name, text );
+        }
+
+        void VTKXMLWriter::add_text( std::string_view text )
+        {
+            if( start_tag_open_ )
+            {
+                stream_ << '>';
+                start_tag_open_ = false;
+            }
+            stream_.write( text.data(), text.size() );
+            has_text_ = true;
+        }
+
+        void VTKXMLWriter::end_element()
+        {
+            OpenGeodeIOImageException::check_exception( !elements_.empty(),
+                nullptr, OpenGeodeException::TYPE::internal,
+                "[VTKXMLWriter::end_element] No element to end" );
+            if( start_tag_open_ )
+            {
+                stream_ << " />\n";
+            }
+            else
+            {
+                if( !has_text_ )
+                {
+                    indent( elements_.size() - 1 );
+                }
+                stream_ << "</" << elements_.back() << ">\n";
+            }
+            elements_.pop_back();
+            start_tag_open_ = false;
+            has_text_ = false;
+        }
+
+        std::string_view VTKXMLWriter::current_element() const
+        {
+            if( elements_.empty() )
+            {
+                return {};
+            }
+            return elements_.back();
+        }
+
+        void VTKXMLWriter::close_start_tag()
+        {
+            if( start_tag_open_ )
+            {
+                stream_ << ">\n";
+                start_tag_open_ = false;
+            }
+        }
+
+        void VTKXMLWriter::indent( size_t depth )
+        {
+            for( size_t level = 0; level < depth; level++ )
+            {
+                stream_.put( '\t' );
+            }
+        }
+    } // namespace detail
+} // namespace geode
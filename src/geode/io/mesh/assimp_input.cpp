@@ -48,7 +48,8 @@
 namespace
 {
     template < typename Mesh >
-    std::unique_ptr< Mesh > build_mesh( const aiMesh& assimp_mesh )
+    std::unique_ptr< Mesh > build_mesh(
+        const aiMesh& assimp_mesh, bool compute_adjacencies )
     {
         auto mesh = Mesh::create();
         auto builder = Mesh::Builder::create( *mesh );
@@ -71,7 +72,10 @@ namespace
             }
             builder->create_polygon( polygon_vertices );
         }
-        builder->compute_polygon_adjacencies();
+        if( compute_adjacencies )
+        {
+            builder->compute_polygon_adjacencies();
+        }
         return mesh;
     }
 } // namespace
@@ -155,8 +159,8 @@ namespace geode
             for( const auto i : Range{ assimp_scene->mNumMeshes } )
             {
                 tasks[i] = async::spawn( [this, i, &assimp_scene] {
-                    surfaces_[i] =
-                        build_mesh< Mesh >( *assimp_scene->mMeshes[i] );
+                    surfaces_[i] = build_mesh< Mesh >(
+                        *assimp_scene->mMeshes[i], compute_adjacencies_ );
                 } );
             }
             for( auto& task :
@@ -181,7 +185,11 @@ namespace geode
 
             std::unique_ptr< Mesh > merged{ dynamic_cast< Mesh* >(
                 merger.merge( GLOBAL_EPSILON ).release() ) };
-            Mesh::Builder::create( *merged )->compute_polygon_adjacencies();
+            if( compute_adjacencies_ )
+            {
+                Mesh::Builder::create( *merged )
+                    ->compute_polygon_adjacencies();
+            }
             auto merged_manager = merged->texture_manager();
             for( const auto s : Indices{ surfaces_ } )
             {
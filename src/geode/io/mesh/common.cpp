@@ -79,9 +79,15 @@ namespace
         geode::PolygonalSurfaceInputFactory3D::register_creator<
             geode::detail::VTPInput >(
             geode::detail::VTPInput::extension().data() );
+        geode::PolygonalSurfaceInputFactory3D::register_creator<
+            geode::detail::VTPInput >(
+            geode::detail::VTPInput::partitioned_extension().data() );
         geode::PolygonalSurfaceInputFactory3D::register_creator<
             geode::detail::VTUPolygonalInput >(
             geode::detail::VTUPolygonalInput::extension().data() );
+        geode::PolygonalSurfaceInputFactory3D::register_creator<
+            geode::detail::VTUPolygonalInput >(
+            geode::detail::VTUPolygonalInput::partitioned_extension().data() );
     }
 
     void register_polyhedral_solid_input()
@@ -89,6 +95,9 @@ namespace
         geode::PolyhedralSolidInputFactory3D::register_creator<
             geode::detail::VTUPolyhedralInput >(
             geode::detail::VTUPolyhedralInput::extension().data() );
+        geode::PolyhedralSolidInputFactory3D::register_creator<
+            geode::detail::VTUPolyhedralInput >(
+            geode::detail::VTUPolyhedralInput::partitioned_extension().data() );
     }
 
     void register_tetrahedral_solid_input()
@@ -96,6 +105,10 @@ namespace
         geode::TetrahedralSolidInputFactory3D::register_creator<
             geode::detail::VTUTetrahedralInput >(
             geode::detail::VTUTetrahedralInput::extension().data() );
+        geode::TetrahedralSolidInputFactory3D::register_creator<
+            geode::detail::VTUTetrahedralInput >(
+            geode::detail::VTUTetrahedralInput::partitioned_extension()
+                .data() );
     }
 
     void register_hybrid_solid_input()
@@ -103,6 +116,9 @@ namespace
         geode::HybridSolidInputFactory3D::register_creator<
             geode::detail::VTUHybridInput >(
             geode::detail::VTUHybridInput::extension().data() );
+        geode::HybridSolidInputFactory3D::register_creator<
+            geode::detail::VTUHybridInput >(
+            geode::detail::VTUHybridInput::partitioned_extension().data() );
     }
 
     void register_triangulated_surface_input()
@@ -116,6 +132,10 @@ namespace
         geode::TriangulatedSurfaceInputFactory3D::register_creator<
             geode::detail::VTUTriangulatedInput >(
             geode::detail::VTUTriangulatedInput::extension().data() );
+        geode::TriangulatedSurfaceInputFactory3D::register_creator<
+            geode::detail::VTUTriangulatedInput >(
+            geode::detail::VTUTriangulatedInput::partitioned_extension()
+                .data() );
     }
 
     void register_polygonal_surface_output()
@@ -170,6 +190,10 @@ namespace
         geode::PolyhedralSolidOutputFactory3D::register_creator<
             geode::detail::VTUPolyhedralOutput >(
             geode::detail::VTUPolyhedralOutput::extension().data() );
+        geode::PolyhedralSolidOutputFactory3D::register_creator<
+            geode::detail::VTUPolyhedralOutput >(
+            geode::detail::VTUPolyhedralOutput::partitioned_extension()
+                .data() );
     }
 
     void register_tetrahedral_solid_output()
@@ -177,6 +201,10 @@ namespace
         geode::TetrahedralSolidOutputFactory3D::register_creator<
             geode::detail::VTUTetrahedralOutput >(
             geode::detail::VTUTetrahedralOutput::extension().data() );
+        geode::TetrahedralSolidOutputFactory3D::register_creator<
+            geode::detail::VTUTetrahedralOutput >(
+            geode::detail::VTUTetrahedralOutput::partitioned_extension()
+                .data() );
     }
 
     void register_hybrid_solid_output()
@@ -184,6 +212,9 @@ namespace
         geode::HybridSolidOutputFactory3D::register_creator<
             geode::detail::VTUHybridOutput >(
             geode::detail::VTUHybridOutput::extension().data() );
+        geode::HybridSolidOutputFactory3D::register_creator<
+            geode::detail::VTUHybridOutput >(
+            geode::detail::VTUHybridOutput::partitioned_extension().data() );
     }
 
     void register_point_set_input()
@@ -236,10 +267,18 @@ namespace
         geode::RegularGridInputFactory2D::register_creator<
             geode::detail::VTIRegularGridInput< 2 > >(
             geode::detail::VTIRegularGridInput< 2 >::extension().data() );
+        geode::RegularGridInputFactory2D::register_creator<
+            geode::detail::VTIRegularGridInput< 2 > >(
+            geode::detail::VTIRegularGridInput< 2 >::partitioned_extension()
+                .data() );
 
         geode::RegularGridInputFactory3D::register_creator<
             geode::detail::VTIRegularGridInput< 3 > >(
             geode::detail::VTIRegularGridInput< 3 >::extension().data() );
+        geode::RegularGridInputFactory3D::register_creator<
+            geode::detail::VTIRegularGridInput< 3 > >(
+            geode::detail::VTIRegularGridInput< 3 >::partitioned_extension()
+                .data() );
     }
 
     void register_light_regular_grid_output()
@@ -258,10 +297,20 @@ namespace
         geode::LightRegularGridInputFactory2D::register_creator<
             geode::detail::VTILightRegularGridInput< 2 > >(
             geode::detail::VTILightRegularGridInput< 2 >::extension().data() );
+        geode::LightRegularGridInputFactory2D::register_creator<
+            geode::detail::VTILightRegularGridInput< 2 > >(
+            geode::detail::VTILightRegularGridInput<
+                2 >::partitioned_extension()
+                .data() );
 
         geode::LightRegularGridInputFactory3D::register_creator<
             geode::detail::VTILightRegularGridInput< 3 > >(
             geode::detail::VTILightRegularGridInput< 3 >::extension().data() );
+        geode::LightRegularGridInputFactory3D::register_creator<
+            geode::detail::VTILightRegularGridInput< 3 > >(
+            geode::detail::VTILightRegularGridInput<
+                3 >::partitioned_extension()
+                .data() );
     }
 
     void register_graph_output()
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/mesh/detail/mapped_file.hpp>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include <geode/basic/pimpl_impl.hpp>
+
+namespace geode
+{
+    namespace detail
+    {
+        class MappedFile::Impl
+        {
+        public:
+            explicit Impl( std::string_view filename )
+            {
+                try
+                {
+                    map( filename );
+                }
+                catch( ... )
+                {
+                    release();
+                    throw;
+                }
+            }
+
+            ~Impl()
+            {
+                release();
+            }
+
+            char* data()
+            {
+                return data_;
+            }
+
+            const char* data() const
+            {
+                return data_;
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+        private:
+            void map( std::string_view filename )
+            {
+                const auto file = to_string( filename );
+#ifdef _WIN32
+                file_ = CreateFileA( file.c_str(), GENERIC_READ,
+                    FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                    nullptr );
+                OpenGeodeIOMeshException::check_exception(
+                    file_ != INVALID_HANDLE_VALUE, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[MappedFile] Error while opening file: ", filename );
+                LARGE_INTEGER file_size;
+                GetFileSizeEx( file_, &file_size );
+                size_ = static_cast< size_t >( file_size.QuadPart );
+                check_size( filename );
+                mapping_ = CreateFileMappingA(
+                    file_, nullptr, PAGE_WRITECOPY, 0, 0, nullptr );
+                OpenGeodeIOMeshException::check_exception( mapping_ != nullptr,
+                    nullptr, OpenGeodeException::TYPE::internal,
+                    "[MappedFile] Error while mapping file: ", filename );
+                data_ = static_cast< char* >(
+                    MapViewOfFile( mapping_, FILE_MAP_COPY, 0, 0, 0 ) );
+#else
+                file_ = open( file.c_str(), O_RDONLY );
+                OpenGeodeIOMeshException::check_exception( file_ != -1,
+                    nullptr, OpenGeodeException::TYPE::data,
+                    "[MappedFile] Error while opening file: ", filename );
+                struct stat file_status;
+                fstat( file_, &file_status );
+                size_ = static_cast< size_t >( file_status.st_size );
+                check_size( filename );
+                auto* data = mmap( nullptr, size_, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE, file_, 0 );
+                data_ = data == MAP_FAILED ? nullptr
+                                           : static_cast< char* >( data );
+                if( data_ )
+                {
+                    madvise( data_, size_, MADV_SEQUENTIAL );
+                }
+#endif
+                OpenGeodeIOMeshException::check_exception( data_ != nullptr,
+                    nullptr, OpenGeodeException::TYPE::internal,
+                    "[MappedFile] Error while mapping file: ", filename );
+            }
+
+            void release()
+            {
+#ifdef _WIN32
+                if( data_ )
+                {
+                    UnmapViewOfFile( data_ );
+                }
+                if( mapping_ )
+                {
+                    CloseHandle( mapping_ );
+                }
+                if( file_ != INVALID_HANDLE_VALUE )
+                {
+                    CloseHandle( file_ );
+                }
+#else
+                if( data_ )
+                {
+                    munmap( data_, size_ );
+                }
+                if( file_ != -1 )
+                {
+                    close( file_ );
+                }
+#endif
+            }
+
+            void check_size( std::string_view filename ) const
+            {
+                OpenGeodeIOMeshException::check_exception( size_ > 0, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[MappedFile] Cannot map empty file: ", filename );
+            }
+
+        private:
+#ifdef _WIN32
+            HANDLE file_{ INVALID_HANDLE_VALUE };
+            HANDLE mapping_{ nullptr };
+#else
+            int file_{ -1 };
+#endif
+            char* data_{ nullptr };
+            size_t size_{ 0 };
+        };
+
+        MappedFile::MappedFile( std::string_view filename )
+            : impl_{ filename }
+        {
+        }
+
+        MappedFile::MappedFile( MappedFile&& other ) = default;
+
+        MappedFile::~MappedFile() = default;
+
+        char* MappedFile::data()
+        {
+            return impl_->data();
+        }
+
+        const char* MappedFile::data() const
+        {
+            return impl_->data();
+        }
+
+        size_t MappedFile::size() const
+        {
+            return impl_->size();
+        }
+    } // namespace detail
+} // namespace geode
@@ -32,6 +32,8 @@
 
 #include <geode/mesh/core/triangulated_surface.hpp>
 
+#include <geode/io/image/detail/text_writer.hpp>
+
 namespace
 {
     static constexpr char EOL{ '\n' };
@@ -40,19 +42,21 @@ namespace
     void write_node(
         const std::string& filename, const geode::TriangulatedSurface2D& mesh )
     {
-        std::ofstream node{ filename };
+        std::ofstream stream{ filename };
+        geode::detail::TextWriter node{ stream };
         node << mesh.nb_vertices() << " 2 0 0" << EOL;
         for( const auto v : geode::Range{ mesh.nb_vertices() } )
         {
-            node << v << SPACE << mesh.point( v ).string() << EOL;
+            node << v << SPACE << mesh.point( v ) << EOL;
         }
-        node << std::flush;
+        node.flush();
     }
 
     void write_ele(
         const std::string& filename, const geode::TriangulatedSurface2D& mesh )
     {
-        std::ofstream ele{ filename };
+        std::ofstream stream{ filename };
+        geode::detail::TextWriter ele{ stream };
         ele << mesh.nb_polygons() << " 3 0" << EOL;
         for( const auto p : geode::Range{ mesh.nb_polygons() } )
         {
@@ -63,13 +67,14 @@ namespace
             }
             ele << EOL;
         }
-        ele << std::flush;
+        ele.flush();
     }
 
     void write_neigh(
         const std::string& filename, const geode::TriangulatedSurface2D& mesh )
     {
-        std::ofstream neigh{ filename };
+        std::ofstream stream{ filename };
+        geode::detail::TextWriter neigh{ stream };
         neigh << mesh.nb_polygons() << " 3" << EOL;
         for( const auto p : geode::Range{ mesh.nb_polygons() } )
         {
@@ -88,7 +93,7 @@ namespace
             }
             neigh << EOL;
         }
-        neigh << std::flush;
+        neigh.flush();
     }
 } // namespace
 
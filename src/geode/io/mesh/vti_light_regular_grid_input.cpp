@@ -47,6 +47,14 @@ namespace
         }
 
     private:
+        std::unique_ptr< geode::detail::VTKInputImpl<
+            geode::LightRegularGrid< dimension > > >
+            create_piece_reader( std::string_view filename ) const final
+        {
+            return std::make_unique< VTILightRegularGridInputImpl >(
+                filename );
+        }
+
         void build_grid( const pugi::xml_node& vtk_object ) final
         {
             auto grid_attributes = this->read_grid_attributes( vtk_object );
@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/mesh/vti_mapped_arrays.hpp>
+
+#include <array>
+#include <cstring>
+#include <list>
+#include <mutex>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/strings/match.h>
+
+#include <geode/basic/pimpl_impl.hpp>
+
+#include <geode/io/image/detail/vtk_compressor.hpp>
+
+#include <geode/io/mesh/detail/vtk_document.hpp>
+
+namespace
+{
+    template < typename T >
+    double read_value( const char* bytes )
+    {
+        T value;
+        std::memcpy( &value, bytes, sizeof( T ) );
+        return static_cast< double >( value );
+    }
+
+    struct VTKValueType
+    {
+        std::string_view name;
+        size_t size;
+        double ( *read )( const char* );
+    };
+
+    constexpr std::array< VTKValueType, 10 > VTK_VALUE_TYPES{ {
+        { "Float32", sizeof( float ), &read_value< float > },
+        { "Float64", sizeof( double ), &read_value< double > },
+        { "Int8", sizeof( int8_t ), &read_value< int8_t > },
+        { "UInt8", sizeof( uint8_t ), &read_value< uint8_t > },
+        { "Int16", sizeof( int16_t ), &read_value< int16_t > },
+        { "UInt16", sizeof( uint16_t ), &read_value< uint16_t > },
+        { "Int32", sizeof( int32_t ), &read_value< int32_t > },
+        { "UInt32", sizeof( uint32_t ), &read_value< uint32_t > },
+        { "Int64", sizeof( int64_t ), &read_value< int64_t > },
+        { "UInt64", sizeof( uint64_t ), &read_value< uint64_t > },
+    } };
+
+    const VTKValueType* find_value_type( std::string_view name )
+    {
+        for( const auto& type : VTK_VALUE_TYPES )
+        {
+            if( type.name == name )
+            {
+                return &type;
+            }
+        }
+        return nullptr;
+    }
+
+    /*!
+     * Values of an appended DataArray, either uncompressed (a single
+     * block) or split into compressed blocks
+     */
+    struct MappedArray
+    {
+        const VTKValueType* type{ nullptr };
+        geode::index_t nb_components{ 1 };
+        size_t nb_bytes{ 0 };
+        /*! Uncompressed values, or concatenated compressed blocks */
+        std::string_view data;
+        /*! Uncompressed size of each block but the last one */
+        size_t block_size{ 0 };
+        std::vector< size_t > block_offsets;
+    };
+
+    /*!
+     * Reader of the header values of the appended arrays
+     */
+    class HeaderReader
+    {
+    public:
+        HeaderReader( std::string_view data, bool is_uint64 )
+            : data_{ data }, size_{ is_uint64 ? sizeof( uint64_t )
+                                              : sizeof( uint32_t ) }
+        {
+        }
+
+        size_t next()
+        {
+            geode::OpenGeodeIOMeshException::check_exception(
+                position_ + size_ <= data_.size(), nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[VTIMappedArrays] Truncated DataArray header" );
+            const auto* bytes = data_.data() + position_;
+            position_ += size_;
+            if( size_ == sizeof( uint64_t ) )
+            {
+                uint64_t value;
+                std::memcpy( &value, bytes, sizeof( value ) );
+                return static_cast< size_t >( value );
+            }
+            uint32_t value;
+            std::memcpy( &value, bytes, sizeof( value ) );
+            return value;
+        }
+
+        std::string_view remaining( size_t size ) const
+        {
+            geode::OpenGeodeIOMeshException::check_exception(
+                position_ + size <= data_.size(), nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[VTIMappedArrays] Truncated DataArray values" );
+            return data_.substr( position_, size );
+        }
+
+    private:
+        std::string_view data_;
+        size_t size_;
+        size_t position_{ 0 };
+    };
+} // namespace
+
+namespace geode
+{
+    class VTIMappedArrays::Impl
+    {
+        using BlockKey = std::pair< index_t, size_t >;
+        using Block = std::pair< BlockKey, std::vector< char > >;
+
+    public:
+        Impl( std::string_view filename, size_t cache_size )
+            : document_{ filename, true },
+              compressor_{ detail::VTKCompressor::from_vtk_name(
+                  document_.root().attribute( "compressor" ).value() ) },
+              cache_size_{ cache_size }
+        {
+            const auto& root = document_.root();
+            OpenGeodeIOMeshException::check_exception(
+                std::string_view{ root.attribute( "type" ).value() }
+                    == "ImageData",
+                nullptr, OpenGeodeException::TYPE::data,
+                "[VTIMappedArrays] File ", filename,
+                " should be a .vti file" );
+            OpenGeodeIOMeshException::check_exception(
+                std::string_view{ root.attribute( "byte_order" ).value() }
+                    != "BigEndian",
+                nullptr, OpenGeodeException::TYPE::internal,
+                "[VTIMappedArrays] Big Endian not supported" );
+            const auto piece = root.child( "ImageData" ).child( "Piece" );
+            OpenGeodeIOMeshException::check_exception(
+                !piece.next_sibling( "Piece" ), nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTIMappedArrays] File ", filename,
+                " should be made of a single piece" );
+            if( !document_.has_raw_appended_data() )
+            {
+                return;
+            }
+            const auto is_uint64 = absl::EndsWith(
+                root.attribute( "header_type" ).value(), "UInt64" );
+            map_arrays( piece.child( "PointData" ), "PointData", is_uint64 );
+            map_arrays( piece.child( "CellData" ), "CellData", is_uint64 );
+        }
+
+        const std::vector< VTKDataArrayInfo >& arrays() const
+        {
+            return infos_;
+        }
+
+        index_t array_index(
+            std::string_view location, std::string_view name ) const
+        {
+            for( const auto a : Indices{ infos_ } )
+            {
+                if( infos_[a].location == location && infos_[a].name == name )
+                {
+                    return a;
+                }
+            }
+            return NO_ID;
+        }
+
+        index_t nb_elements( index_t array ) const
+        {
+            const auto& mapped = arrays_.at( array );
+            return static_cast< index_t >( mapped.nb_bytes
+                                           / mapped.type->size
+                                           / mapped.nb_components );
+        }
+
+        double value(
+            index_t array, index_t element, local_index_t component ) const
+        {
+            const auto& mapped = arrays_.at( array );
+            OpenGeodeIOMeshException::check_exception(
+                component < mapped.nb_components, nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTIMappedArrays::value] Wrong component" );
+            const auto byte = ( static_cast< size_t >( element )
+                                      * mapped.nb_components
+                                  + component )
+                              * mapped.type->size;
+            OpenGeodeIOMeshException::check_exception(
+                byte + mapped.type->size <= mapped.nb_bytes, nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTIMappedArrays::value] Wrong element" );
+            if( mapped.block_offsets.empty() )
+            {
+                return mapped.type->read( mapped.data.data() + byte );
+            }
+            const auto block = byte / mapped.block_size;
+            const auto block_byte = byte % mapped.block_size;
+            {
+                std::lock_guard< std::mutex > lock{ mutex_ };
+                if( const auto* values = cached_block( { array, block } ) )
+                {
+                    return mapped.type->read( values->data() + block_byte );
+                }
+            }
+            // Blocks are decompressed outside of the lock, so that several
+            // blocks may be decompressed concurrently
+            auto values = decompress_block( mapped, block );
+            const auto result = mapped.type->read( values.data() + block_byte );
+            std::lock_guard< std::mutex > lock{ mutex_ };
+            if( !cached_block( { array, block } ) )
+            {
+                add_block( { array, block }, std::move( values ) );
+            }
+            return result;
+        }
+
+    private:
+        void map_arrays( const pugi::xml_node& data_node,
+            const char* location,
+            bool is_uint64 )
+        {
+            const auto appended_data = document_.appended_data();
+            for( const auto& data : data_node.children( "DataArray" ) )
+            {
+                const auto* type =
+                    find_value_type( data.attribute( "type" ).value() );
+                if( !type
+                    || std::string_view{ data.attribute( "format" ).value() }
+                           != "appended" )
+                {
+                    continue;
+                }
+                const auto offset = data.attribute( "offset" ).as_ullong();
+                OpenGeodeIOMeshException::check_exception(
+                    offset <= appended_data.size(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[VTIMappedArrays] DataArray offset is out of "
+                    "AppendedData section" );
+                MappedArray mapped;
+                mapped.type = type;
+                mapped.nb_components =
+                    data.attribute( "NumberOfComponents" ).as_uint( 1 );
+                HeaderReader header{ appended_data.substr( offset ),
+                    is_uint64 };
+                if( compressor_.is_compressed() )
+                {
+                    read_compressed_header( header, mapped );
+                }
+                else
+                {
+                    mapped.nb_bytes = header.next();
+                    mapped.data = header.remaining( mapped.nb_bytes );
+                }
+                auto& info = infos_.emplace_back();
+                info.name = data.attribute( "Name" ).value();
+                info.type = type->name;
+                info.nb_components = mapped.nb_components;
+                info.location = location;
+                arrays_.emplace_back( std::move( mapped ) );
+            }
+        }
+
+        static void read_compressed_header(
+            HeaderReader& header, MappedArray& mapped )
+        {
+            // Header is [nb blocks, block size, last block size, compressed
+            // block sizes...], followed by the compressed blocks
+            const auto nb_blocks = header.next();
+            mapped.block_size = header.next();
+            OpenGeodeIOMeshException::check_exception(
+                nb_blocks == 0 || mapped.block_size > 0, nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTIMappedArrays] Wrong compressed block size" );
+            const auto last_block_size = header.next();
+            mapped.block_offsets.resize( nb_blocks + 1, 0 );
+            for( size_t b = 0; b < nb_blocks; b++ )
+            {
+                mapped.block_offsets[b + 1] =
+                    mapped.block_offsets[b] + header.next();
+            }
+            mapped.data = header.remaining( mapped.block_offsets.back() );
+            if( nb_blocks > 0 )
+            {
+                mapped.nb_bytes =
+                    ( nb_blocks - 1 ) * mapped.block_size
+                    + ( last_block_size == 0 ? mapped.block_size
+                                             : last_block_size );
+            }
+        }
+
+        std::vector< char > decompress_block(
+            const MappedArray& mapped, size_t block ) const
+        {
+            const auto start = block * mapped.block_size;
+            std::vector< char > values(
+                std::min( mapped.block_size, mapped.nb_bytes - start ) );
+            compressor_.decompress_block(
+                mapped.data.substr( mapped.block_offsets[block],
+                    mapped.block_offsets[block + 1]
+                        - mapped.block_offsets[block] ),
+                absl::MakeSpan( values ) );
+            return values;
+        }
+
+        /*!
+         * Return the cached block values, marked as the most recently used
+         * block, or nullptr if the block is not cached
+         */
+        const std::vector< char >* cached_block( const BlockKey& key ) const
+        {
+            const auto it = cache_positions_.find( key );
+            if( it == cache_positions_.end() )
+            {
+                return nullptr;
+            }
+            cache_.splice( cache_.begin(), cache_, it->second );
+            return &it->second->second;
+        }
+
+        void add_block(
+            const BlockKey& key, std::vector< char >&& values ) const
+        {
+            cached_size_ += values.size();
+            cache_.emplace_front( key, std::move( values ) );
+            cache_positions_.emplace( key, cache_.begin() );
+            while( cached_size_ > cache_size_ && cache_.size() > 1 )
+            {
+                const auto& evicted = cache_.back();
+                cached_size_ -= evicted.second.size();
+                cache_positions_.erase( evicted.first );
+                cache_.pop_back();
+            }
+        }
+
+    private:
+        detail::VTKDocument document_;
+        detail::VTKCompressor compressor_;
+        std::vector< VTKDataArrayInfo > infos_;
+        std::vector< MappedArray > arrays_;
+        size_t cache_size_;
+        mutable std::mutex mutex_;
+        /*! Cached blocks, from the most to the least recently used */
+        mutable std::list< Block > cache_;
+        mutable absl::flat_hash_map< BlockKey, std::list< Block >::iterator >
+            cache_positions_;
+        mutable size_t cached_size_{ 0 };
+    };
+
+    VTIMappedArrays::VTIMappedArrays(
+        std::string_view filename, size_t cache_size )
+        : impl_{ filename, cache_size }
+    {
+    }
+
+    VTIMappedArrays::~VTIMappedArrays() = default;
+
+    const std::vector< VTKDataArrayInfo >& VTIMappedArrays::arrays() const
+    {
+        return impl_->arrays();
+    }
+
+    index_t VTIMappedArrays::array_index(
+        std::string_view location, std::string_view name ) const
+    {
+        return impl_->array_index( location, name );
+    }
+
+    index_t VTIMappedArrays::nb_elements( index_t array ) const
+    {
+        return impl_->nb_elements( array );
+    }
+
+    double VTIMappedArrays::value(
+        index_t array, index_t element, local_index_t component ) const
+    {
+        return impl_->value( array, element, component );
+    }
+} // namespace geode
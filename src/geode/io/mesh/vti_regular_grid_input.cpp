@@ -35,6 +35,7 @@
 #include <geode/mesh/core/regular_grid_surface.hpp>
 
 #include <geode/io/mesh/detail/vti_grid_input.hpp>
+#include <geode/io/mesh/vti_mapped_arrays.hpp>
 
 namespace
 {
@@ -46,13 +47,22 @@ namespace
         VTIRegularGridInputImpl(
             std::string_view filename, const geode::MeshImpl& impl )
             : geode::detail::VTIGridInputImpl<
-                  geode::RegularGrid< dimension > >{ filename }
+                  geode::RegularGrid< dimension > >{ filename },
+              impl_{ impl }
         {
             this->initialize_mesh(
                 geode::RegularGrid< dimension >::create( impl ) );
         }
 
     private:
+        std::unique_ptr<
+            geode::detail::VTKInputImpl< geode::RegularGrid< dimension > > >
+            create_piece_reader( std::string_view filename ) const final
+        {
+            return std::make_unique< VTIRegularGridInputImpl >(
+                filename, impl_ );
+        }
+
         void build_grid( const pugi::xml_node& vtk_object ) final
         {
             const auto grid_attributes =
@@ -62,6 +72,9 @@ namespace
             builder->initialize_grid( grid_attributes.origin,
                 grid_attributes.cells_number, grid_attributes.cell_directions );
         }
+
+    private:
+        geode::MeshImpl impl_;
     };
 } // namespace
 
@@ -90,4 +103,23 @@ namespace geode
         template class VTIRegularGridInput< 2 >;
         template class VTIRegularGridInput< 3 >;
     } // namespace detail
+
+    template < index_t dimension >
+    MappedRegularGrid< dimension > load_mapped_regular_grid(
+        std::string_view filename, size_t cache_size )
+    {
+        // View is opened first: it checks the file can be mapped
+        auto arrays =
+            std::make_unique< VTIMappedArrays >( filename, cache_size );
+        VTIRegularGridInputImpl< dimension > reader{ filename,
+            MeshFactory::default_impl(
+                RegularGrid< dimension >::type_name_static() ) };
+        reader.skip_mapped_arrays();
+        return { reader.read_file(), std::move( arrays ) };
+    }
+
+    template MappedRegularGrid< 2 > opengeode_io_mesh_api
+        load_mapped_regular_grid< 2 >( std::string_view, size_t );
+    template MappedRegularGrid< 3 > opengeode_io_mesh_api
+        load_mapped_regular_grid< 3 >( std::string_view, size_t );
 } // namespace geode
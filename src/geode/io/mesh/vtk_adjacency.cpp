@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/mesh/detail/vtk_adjacency.hpp>
+
+#include <algorithm>
+
+#include <absl/algorithm/container.h>
+
+#include <geode/mesh/builder/solid_mesh_builder.hpp>
+#include <geode/mesh/builder/surface_mesh_builder.hpp>
+#include <geode/mesh/core/solid_mesh.hpp>
+#include <geode/mesh/core/surface_mesh.hpp>
+
+namespace
+{
+    constexpr int64_t NO_ADJACENT{ -1 };
+
+    template < typename NbFacets, typename Adjacent >
+    geode::detail::VTKAdjacencies compute_adjacencies(
+        geode::index_t nb_elements,
+        const NbFacets& nb_facets,
+        const Adjacent& adjacent )
+    {
+        geode::detail::VTKAdjacencies adjacencies;
+        for( const auto e : geode::Range{ nb_elements } )
+        {
+            adjacencies.nb_components =
+                std::max( adjacencies.nb_components, nb_facets( e ) );
+        }
+        const auto nb_components = adjacencies.nb_components;
+        adjacencies.values.resize(
+            static_cast< size_t >( nb_elements ) * nb_components,
+            NO_ADJACENT );
+        for( const auto e : geode::Range{ nb_elements } )
+        {
+            for( const auto f : geode::LRange{ nb_facets( e ) } )
+            {
+                if( const auto element = adjacent( e, f ) )
+                {
+                    adjacencies.values[static_cast< size_t >( e )
+                                           * nb_components
+                                       + f] = element.value();
+                }
+            }
+        }
+        return adjacencies;
+    }
+
+    /*!
+     * Check that every stored adjacency refers to an existing element
+     * which is adjacent back through a facet made of the same vertices.
+     * Only the facets of the adjacent elements are visited, which is much
+     * cheaper than matching every facet of the mesh.
+     */
+    template < typename NbFacets, typename SortedFacetVertices >
+    bool are_adjacencies_valid( geode::index_t nb_elements,
+        absl::Span< const int64_t > adjacencies,
+        geode::index_t nb_components,
+        const NbFacets& nb_facets,
+        const SortedFacetVertices& sorted_facet_vertices )
+    {
+        if( adjacencies.size()
+            != static_cast< size_t >( nb_elements ) * nb_components )
+        {
+            return false;
+        }
+        const auto adjacency = [&adjacencies, nb_components](
+                                   geode::index_t element,
+                                   geode::local_index_t facet ) {
+            return adjacencies[static_cast< size_t >( element ) * nb_components
+                               + facet];
+        };
+        for( const auto e : geode::Range{ nb_elements } )
+        {
+            const auto nb_element_facets = nb_facets( e );
+            if( nb_element_facets > nb_components )
+            {
+                return false;
+            }
+            for( const auto f : geode::LRange{ nb_element_facets } )
+            {
+                const auto adjacent = adjacency( e, f );
+                if( adjacent == NO_ADJACENT )
+                {
+                    continue;
+                }
+                if( adjacent < 0 || adjacent >= nb_elements || adjacent == e )
+                {
+                    return false;
+                }
+                const auto element = static_cast< geode::index_t >( adjacent );
+                const auto vertices = sorted_facet_vertices( e, f );
+                bool found{ false };
+                for( const auto g : geode::LRange{ nb_facets( element ) } )
+                {
+                    if( adjacency( element, g ) == e
+                        && sorted_facet_vertices( element, g ) == vertices )
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if( !found )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+} // namespace
+
+namespace geode
+{
+    namespace detail
+    {
+        VTKAdjacencies vtk_polyhedron_adjacencies( const SolidMesh3D& solid )
+        {
+            return compute_adjacencies(
+                solid.nb_polyhedra(),
+                [&solid]( index_t p ) {
+                    return solid.nb_polyhedron_facets( p );
+                },
+                [&solid]( index_t p, local_index_t f ) {
+                    return solid.polyhedron_adjacent( { p, f } );
+                } );
+        }
+
+        template < index_t dimension >
+        VTKAdjacencies vtk_polygon_adjacencies(
+            const SurfaceMesh< dimension >& surface )
+        {
+            return compute_adjacencies(
+                surface.nb_polygons(),
+                [&surface]( index_t p ) {
+                    return surface.nb_polygon_edges( p );
+                },
+                [&surface]( index_t p, local_index_t e ) {
+                    return surface.polygon_adjacent( { p, e } );
+                } );
+        }
+
+        bool set_vtk_polyhedron_adjacencies( const SolidMesh3D& solid,
+            SolidMeshBuilder3D& builder,
+            absl::Span< const int64_t > adjacencies,
+            index_t nb_components )
+        {
+            const auto nb_facets = [&solid]( index_t p ) {
+                return solid.nb_polyhedron_facets( p );
+            };
+            const auto sorted_facet_vertices =
+                [&solid]( index_t p, local_index_t f ) {
+                    auto vertices =
+                        solid.polyhedron_facet_vertices( { p, f } );
+                    absl::c_sort( vertices );
+                    return vertices;
+                };
+            if( !are_adjacencies_valid( solid.nb_polyhedra(), adjacencies,
+                    nb_components, nb_facets, sorted_facet_vertices ) )
+            {
+                return false;
+            }
+            for( const auto p : Range{ solid.nb_polyhedra() } )
+            {
+                for( const auto f : LRange{ nb_facets( p ) } )
+                {
+                    const auto adjacent =
+                        adjacencies[static_cast< size_t >( p ) * nb_components
+                                    + f];
+                    if( adjacent != NO_ADJACENT )
+                    {
+                        builder.set_polyhedron_adjacent(
+                            { p, f }, static_cast< index_t >( adjacent ) );
+                    }
+                }
+            }
+            return true;
+        }
+
+        template < index_t dimension >
+        bool set_vtk_polygon_adjacencies(
+            const SurfaceMesh< dimension >& surface,
+            SurfaceMeshBuilder< dimension >& builder,
+            absl::Span< const int64_t > adjacencies,
+            index_t nb_components )
+        {
+            const auto nb_edges = [&surface]( index_t p ) {
+                return surface.nb_polygon_edges( p );
+            };
+            const auto sorted_edge_vertices =
+                [&surface]( index_t p, local_index_t e ) {
+                    auto vertices = surface.polygon_edge_vertices( { p, e } );
+                    absl::c_sort( vertices );
+                    return vertices;
+                };
+            if( !are_adjacencies_valid( surface.nb_polygons(), adjacencies,
+                    nb_components, nb_edges, sorted_edge_vertices ) )
+            {
+                return false;
+            }
+            for( const auto p : Range{ surface.nb_polygons() } )
+            {
+                for( const auto e : LRange{ nb_edges( p ) } )
+                {
+                    const auto adjacent =
+                        adjacencies[static_cast< size_t >( p ) * nb_components
+                                    + e];
+                    if( adjacent != NO_ADJACENT )
+                    {
+                        builder.set_polygon_adjacent(
+                            { p, e }, static_cast< index_t >( adjacent ) );
+                    }
+                }
+            }
+            return true;
+        }
+
+        template VTKAdjacencies opengeode_io_mesh_api vtk_polygon_adjacencies(
+            const SurfaceMesh< 2 >& );
+        template VTKAdjacencies opengeode_io_mesh_api vtk_polygon_adjacencies(
+            const SurfaceMesh< 3 >& );
+
+        template bool opengeode_io_mesh_api set_vtk_polygon_adjacencies(
+            const SurfaceMesh< 2 >&,
+            SurfaceMeshBuilder< 2 >&,
+            absl::Span< const int64_t >,
+            index_t );
+        template bool opengeode_io_mesh_api set_vtk_polygon_adjacencies(
+            const SurfaceMesh< 3 >&,
+            SurfaceMeshBuilder< 3 >&,
+            absl::Span< const int64_t >,
+            index_t );
+    } // namespace detail
+} // namespace geode
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/mesh/detail/vtk_cell_types_cache.hpp>
+
+#include <mutex>
+#include <string>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
+
+#include <geode/basic/string.hpp>
+
+namespace
+{
+    /*!
+     * Identification of the encoded types, so that a file rewritten with
+     * the same size and modification time is not mistaken for the cached
+     * one
+     */
+    struct EncodedTypes
+    {
+        explicit EncodedTypes( std::string_view encoded_types )
+            : size{ encoded_types.size() },
+              hash{ absl::Hash< std::string_view >{}( encoded_types ) }
+        {
+        }
+
+        bool operator==( const EncodedTypes& other ) const
+        {
+            return size == other.size && hash == other.hash;
+        }
+
+        size_t size;
+        size_t hash;
+    };
+
+    struct CachedTypes
+    {
+        EncodedTypes encoded;
+        geode::detail::VTKCellTypes types;
+    };
+
+    struct CellTypesCache
+    {
+        std::mutex mutex;
+        std::string filename;
+        absl::flat_hash_map< geode::index_t, CachedTypes > pieces;
+    };
+
+    CellTypesCache& cell_types_cache()
+    {
+        static CellTypesCache cache;
+        return cache;
+    }
+} // namespace
+
+namespace geode
+{
+    namespace detail
+    {
+        void store_vtk_cell_types( std::string_view filename,
+            index_t piece,
+            std::string_view encoded_types,
+            VTKCellTypes types )
+        {
+            CachedTypes cached{ EncodedTypes{ encoded_types },
+                std::move( types ) };
+            auto& cache = cell_types_cache();
+            std::lock_guard< std::mutex > lock{ cache.mutex };
+            if( cache.filename != filename )
+            {
+                cache.filename = to_string( filename );
+                cache.pieces.clear();
+            }
+            cache.pieces.insert_or_assign( piece, std::move( cached ) );
+        }
+
+        VTKCellTypes find_vtk_cell_types( std::string_view filename,
+            index_t piece,
+            std::string_view encoded_types )
+        {
+            const EncodedTypes encoded{ encoded_types };
+            auto& cache = cell_types_cache();
+            std::lock_guard< std::mutex > lock{ cache.mutex };
+            if( cache.filename != filename )
+            {
+                return nullptr;
+            }
+            const auto it = cache.pieces.find( piece );
+            if( it == cache.pieces.end() || !( it->second.encoded == encoded ) )
+            {
+                return nullptr;
+            }
+            return it->second.types;
+        }
+
+        void clear_vtk_cell_types()
+        {
+            auto& cache = cell_types_cache();
+            std::lock_guard< std::mutex > lock{ cache.mutex };
+            cache.filename.clear();
+            cache.pieces.clear();
+        }
+    } // namespace detail
+} // namespace geode
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/mesh/vtk_data_arrays.hpp>
+
+#include <absl/container/flat_hash_set.h>
+
+#include <geode/io/mesh/detail/vtk_document.hpp>
+
+namespace geode
+{
+    std::vector< VTKDataArrayInfo > vtk_data_arrays(
+        std::string_view filename )
+    {
+        const detail::VTKDocument document{ filename, true };
+        const auto type = document.root().attribute( "type" ).value();
+        std::vector< VTKDataArrayInfo > infos;
+        absl::flat_hash_set< std::pair< std::string, std::string > > listed;
+        const auto list_arrays = [&infos, &listed](
+                                     const pugi::xml_node& data_node,
+                                     const char* location ) {
+            for( const auto& data : data_node.children() )
+            {
+                std::string name = data.attribute( "Name" ).value();
+                if( !listed.emplace( location, name ).second )
+                {
+                    continue;
+                }
+                auto& info = infos.emplace_back();
+                info.name = std::move( name );
+                info.type = data.attribute( "type" ).value();
+                info.nb_components =
+                    data.attribute( "NumberOfComponents" ).as_uint( 1 );
+                info.location = location;
+            }
+        };
+        const auto object = document.root().child( type );
+        for( const auto& piece : object.children( "Piece" ) )
+        {
+            list_arrays( piece.child( "PointData" ), "PointData" );
+            list_arrays( piece.child( "CellData" ), "CellData" );
+        }
+        // Partitioned files (.pvtu, .pvtp, .pvti) declare the arrays of
+        // their piece files
+        list_arrays( object.child( "PPointData" ), "PointData" );
+        list_arrays( object.child( "PCellData" ), "CellData" );
+        return infos;
+    }
+} // namespace geode
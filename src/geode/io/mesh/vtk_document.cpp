@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/mesh/detail/vtk_document.hpp>
+
+#include <vector>
+
+#include <absl/strings/ascii.h>
+#include <absl/strings/match.h>
+#include <absl/strings/str_cat.h>
+
+namespace
+{
+    size_t skip_whitespaces( std::string_view text, size_t position )
+    {
+        while( position < text.size() && absl::ascii_isspace( text[position] ) )
+        {
+            position++;
+        }
+        return position;
+    }
+
+    /*!
+     * Value of the given attribute in the text of an XML start tag, or an
+     * empty view if the tag has no such attribute
+     */
+    std::string_view tag_attribute(
+        std::string_view tag, std::string_view attribute )
+    {
+        auto position = tag.find_first_of( " \t\r\n" );
+        while( position < tag.size() )
+        {
+            const auto name_start = skip_whitespaces( tag, position );
+            const auto name_end = tag.find_first_of( "= \t\r\n", name_start );
+            const auto equal = skip_whitespaces( tag, name_end );
+            if( equal >= tag.size() || tag[equal] != '=' )
+            {
+                return {};
+            }
+            const auto quote = skip_whitespaces( tag, equal + 1 );
+            if( quote >= tag.size()
+                || ( tag[quote] != '"' && tag[quote] != '\'' ) )
+            {
+                return {};
+            }
+            const auto value_end = tag.find( tag[quote], quote + 1 );
+            if( value_end == std::string_view::npos )
+            {
+                return {};
+            }
+            if( tag.substr( name_start, name_end - name_start ) == attribute )
+            {
+                return tag.substr( quote + 1, value_end - quote - 1 );
+            }
+            position = value_end + 1;
+        }
+        return {};
+    }
+
+    /*!
+     * Name of the element of an XML start or end tag
+     */
+    std::string_view tag_name( std::string_view tag )
+    {
+        const auto name_start = tag[1] == '/' ? 2 : 1;
+        const auto name_end = tag.find_first_of( " \t\r\n/>", name_start );
+        return tag.substr( name_start, name_end - name_start );
+    }
+
+    bool is_cell_types_array( std::string_view tag )
+    {
+        return tag_attribute( tag, "Name" ) == "types";
+    }
+
+    bool is_raw_encoding( std::string_view appended_tag )
+    {
+        return tag_attribute( appended_tag, "encoding" ) == "raw";
+    }
+} // namespace
+
+namespace geode
+{
+    namespace detail
+    {
+        VTKDocument::VTKDocument( std::string_view filename )
+            : VTKDocument{ filename, false }
+        {
+        }
+
+        VTKDocument::VTKDocument(
+            std::string_view filename, bool header_only )
+            : file_{ filename }
+        {
+            check_root( filename, header_only ? parse_header() : parse() );
+        }
+
+        void VTKDocument::check_root(
+            std::string_view filename, const pugi::xml_parse_result& status )
+        {
+            OpenGeodeIOMeshException::check_exception( status, nullptr,
+                OpenGeodeException::TYPE::internal, status.description(),
+                "[VTKInput] Error while parsing file: ", filename );
+            root_ = document_.child( "VTKFile" );
+            OpenGeodeIOMeshException::check_exception( root_, nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTKInput] Missing VTKFile node in file: ", filename );
+        }
+
+        pugi::xml_parse_result VTKDocument::parse()
+        {
+            const auto content = file_.content();
+            const auto appended_start = content.find( "<AppendedData" );
+            if( appended_start != std::string_view::npos )
+            {
+                const auto appended_tag_end =
+                    content.find( '>', appended_start );
+                const auto appended_tag = content.substr(
+                    appended_start, appended_tag_end - appended_start );
+                if( is_raw_encoding( appended_tag ) )
+                {
+                    // Raw binary values are not valid XML: only the XML part
+                    // preceding them is parsed
+                    read_appended_data_tag( appended_tag, appended_tag_end );
+                    xml_header_ =
+                        absl::StrCat( content.substr( 0, appended_tag_end + 1 ),
+                            "</AppendedData></VTKFile>" );
+                    return document_.load_buffer_inplace(
+                        xml_header_.data(), xml_header_.size() );
+                }
+            }
+            // Parsing in place keeps every node value and every DataArray
+            // payload as a view into the mapped file instead of a copy
+            return document_.load_buffer_inplace( file_.data(), file_.size() );
+        }
+
+        pugi::xml_parse_result VTKDocument::parse_header()
+        {
+            // Only tags are copied: DataArray payloads are skipped without
+            // being parsed, nor written (which would copy the mapped pages).
+            // Every Piece is scanned: inline values are only searched for
+            // the next tag.
+            const auto content = file_.content();
+            std::vector< std::string_view > open_tags;
+            size_t position{ 0 };
+            while( position < content.size() )
+            {
+                const auto tag_start = content.find( '<', position );
+                if( tag_start == std::string_view::npos )
+                {
+                    break;
+                }
+                if( content.compare( tag_start, 4, "<!--" ) == 0 )
+                {
+                    position = content.find( "-->", tag_start );
+                    if( position != std::string_view::npos )
+                    {
+                        position += 3;
+                    }
+                    continue;
+                }
+                const auto tag_end = content.find( '>', tag_start );
+                if( tag_end == std::string_view::npos )
+                {
+                    break;
+                }
+                const auto tag =
+                    content.substr( tag_start, tag_end + 1 - tag_start );
+                xml_header_.append( tag );
+                position = tag_end + 1;
+                if( absl::StartsWith( tag, "<?" )
+                    || absl::StartsWith( tag, "<!" ) )
+                {
+                    continue;
+                }
+                if( absl::StartsWith( tag, "</" ) )
+                {
+                    if( !open_tags.empty() )
+                    {
+                        open_tags.pop_back();
+                    }
+                    continue;
+                }
+                const auto name = tag_name( tag );
+                if( absl::EndsWith( tag, "/>" ) )
+                {
+                    continue;
+                }
+                open_tags.push_back( name );
+                if( name == "AppendedData" )
+                {
+                    read_appended_data_tag( tag, tag_end );
+                    break;
+                }
+                if( name == "DataArray" )
+                {
+                    const auto values_end = content.find( '<', position );
+                    if( is_cell_types_array( tag ) )
+                    {
+                        xml_header_.append(
+                            content.substr( position, values_end - position ) );
+                    }
+                    position = values_end;
+                }
+            }
+            for( auto tag = open_tags.rbegin(); tag != open_tags.rend(); ++tag )
+            {
+                absl::StrAppend( &xml_header_, "</", *tag, ">" );
+            }
+            return document_.load_buffer_inplace(
+                xml_header_.data(), xml_header_.size() );
+        }
+
+        void VTKDocument::read_appended_data_tag(
+            std::string_view appended_tag, size_t appended_tag_end )
+        {
+            const auto content = file_.content();
+            const auto data_start = content.find( '_', appended_tag_end );
+            OpenGeodeIOMeshException::check_exception(
+                data_start != std::string_view::npos, nullptr,
+                OpenGeodeException::TYPE::data,
+                "[VTKInput] Missing AppendedData marker" );
+            has_appended_data_ = true;
+            if( is_raw_encoding( appended_tag ) )
+            {
+                appended_data_ = content.substr( data_start + 1 );
+                has_raw_appended_data_ = true;
+                return;
+            }
+            // Values are read from their offsets: the end of the section is
+            // not searched, which would mean scanning all of them
+            appended_data_ = content.substr( data_start + 1 );
+        }
+    } // namespace detail
+} // namespace geode
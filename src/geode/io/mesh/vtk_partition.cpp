@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/io/mesh/detail/vtk_partition.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include <absl/algorithm/container.h>
+
+namespace
+{
+    geode::local_index_t longest_direction(
+        absl::Span< const geode::Point3D > barycenters,
+        absl::Span< const geode::index_t > elements )
+    {
+        std::array< double, 3 > min;
+        std::array< double, 3 > max;
+        min.fill( std::numeric_limits< double >::max() );
+        max.fill( std::numeric_limits< double >::lowest() );
+        for( const auto e : elements )
+        {
+            for( const auto d : geode::LRange{ 3 } )
+            {
+                const auto value = barycenters[e].value( d );
+                min[d] = std::min( min[d], value );
+                max[d] = std::max( max[d], value );
+            }
+        }
+        geode::local_index_t direction{ 0 };
+        for( const auto d : geode::LRange{ 1, 3 } )
+        {
+            if( max[d] - min[d] > max[direction] - min[direction] )
+            {
+                direction = d;
+            }
+        }
+        return direction;
+    }
+
+    void bisect( absl::Span< const geode::Point3D > barycenters,
+        absl::Span< geode::index_t > elements,
+        geode::index_t nb_parts,
+        std::vector< std::vector< geode::index_t > >& parts )
+    {
+        if( nb_parts == 1 )
+        {
+            auto& part = parts.emplace_back( elements.begin(), elements.end() );
+            absl::c_sort( part );
+            return;
+        }
+        const auto direction = longest_direction( barycenters, elements );
+        const auto nb_first_parts = nb_parts / 2;
+        const auto split = elements.size() * nb_first_parts / nb_parts;
+        std::nth_element( elements.begin(), elements.begin() + split,
+            elements.end(),
+            [&barycenters, direction]( geode::index_t e0, geode::index_t e1 ) {
+                return barycenters[e0].value( direction )
+                       < barycenters[e1].value( direction );
+            } );
+        bisect( barycenters, elements.subspan( 0, split ), nb_first_parts,
+            parts );
+        bisect( barycenters, elements.subspan( split ),
+            nb_parts - nb_first_parts, parts );
+    }
+} // namespace
+
+namespace geode
+{
+    namespace detail
+    {
+        std::vector< std::vector< index_t > > partition_elements(
+            absl::Span< const Point3D > barycenters, index_t nb_parts )
+        {
+            OpenGeodeIOMeshException::check_exception( nb_parts > 0, nullptr,
+                OpenGeodeException::TYPE::data,
+                "[partition_elements] Number of parts should be positive" );
+            std::vector< index_t > elements( barycenters.size() );
+            absl::c_iota( elements, 0 );
+            std::vector< std::vector< index_t > > parts;
+            parts.reserve( nb_parts );
+            bisect( barycenters, absl::MakeSpan( elements ), nb_parts, parts );
+            return parts;
+        }
+    } // namespace detail
+} // namespace geode
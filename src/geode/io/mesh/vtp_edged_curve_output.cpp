@@ -45,57 +45,42 @@ namespace
         }
 
     private:
-        void append_number_elements( pugi::xml_node& piece ) override
+        void append_number_elements() override
         {
-            piece.append_attribute( "NumberOfLines" )
-                .set_value( this->mesh().nb_edges() );
+            this->xml().add_attribute(
+                "NumberOfLines", this->mesh().nb_edges() );
         }
 
-        pugi::xml_node write_vtk_cells( pugi::xml_node& piece ) override
+        void write_vtk_cells() override
         {
-            auto lines = piece.append_child( "Lines" );
-            auto connectivity = lines.append_child( "DataArray" );
-            connectivity.append_attribute( "type" ).set_value( "Int64" );
-            connectivity.append_attribute( "Name" ).set_value( "connectivity" );
-            connectivity.append_attribute( "format" ).set_value( "ascii" );
-            connectivity.append_attribute( "RangeMin" ).set_value( 0 );
-            connectivity.append_attribute( "RangeMax" )
-                .set_value( this->mesh().nb_vertices() - 1 );
-            auto offsets = lines.append_child( "DataArray" );
-            offsets.append_attribute( "type" ).set_value( "Int64" );
-            offsets.append_attribute( "Name" ).set_value( "offsets" );
-            offsets.append_attribute( "format" ).set_value( "ascii" );
-            offsets.append_attribute( "RangeMin" ).set_value( 0 );
-            offsets.append_attribute( "RangeMax" )
-                .set_value( this->mesh().nb_vertices() );
             const auto nb_edges = this->mesh().nb_edges();
-            std::string edge_connectivity;
+            std::vector< int64_t > edge_connectivity;
             edge_connectivity.reserve( nb_edges * 2 );
-            std::string edge_offsets;
+            std::vector< int64_t > edge_offsets;
             edge_offsets.reserve( nb_edges );
             geode::index_t vertex_count{ 0 };
             for( const auto e : geode::Range{ nb_edges } )
             {
                 vertex_count += 2;
-                absl::StrAppend( &edge_offsets, vertex_count, " " );
+                edge_offsets.push_back( vertex_count );
                 for( const auto v : geode::LRange{ 2 } )
                 {
-                    absl::StrAppend( &edge_connectivity,
-                        this->mesh().edge_vertex( { e, v } ), " " );
+                    edge_connectivity.push_back(
+                        this->mesh().edge_vertex( { e, v } ) );
                 }
             }
-            connectivity.text().set( edge_connectivity.c_str() );
-            offsets.text().set( edge_offsets.c_str() );
-            return lines;
+            auto& xml = this->xml();
+            xml.start_element( "Lines" );
+            this->write_index_data_array( "connectivity", edge_connectivity );
+            this->write_index_data_array( "offsets", edge_offsets );
+            xml.end_element();
         }
 
-        pugi::xml_node write_vtk_cell_attributes(
-            pugi::xml_node& piece ) override
+        void write_vtk_cell_attributes() override
         {
-            auto cell_data = piece.append_child( "CellData" );
-            this->write_attributes(
-                cell_data, this->mesh().edge_attribute_manager() );
-            return cell_data;
+            this->xml().start_element( "CellData" );
+            this->write_attributes( this->mesh().edge_attribute_manager() );
+            this->xml().end_element();
         }
     };
 } // namespace
@@ -42,34 +42,72 @@ namespace
         }
 
     private:
-        void read_vtk_cells( const pugi::xml_node& piece ) override
+        PieceReader create_piece_reader(
+            std::string_view filename ) const override
+        {
+            return std::make_unique< VTPInputImpl >( filename, mesh_impl() );
+        }
+
+        geode::detail::VTKCells read_vtk_cells(
+            const pugi::xml_node& piece ) const override
         {
             const auto nb_polygons = read_attribute( piece, "NumberOfPolys" );
-            const auto polygon_offset =
-                build_polygons( read_polygons( piece, nb_polygons ) );
-            this->read_data( piece.child( "CellData" ), polygon_offset,
-                this->mesh().polygon_attribute_manager() );
+            return read_polygons( piece, nb_polygons );
+        }
+
+        geode::index_t build_vtk_cells(
+            const geode::detail::VTKCells& cells ) override
+        {
+            const auto polygons_offset = mesh().nb_polygons();
+            for( const auto p : geode::Range{ cells.nb_cells() } )
+            {
+                builder().create_polygon( cells.cell_vertices( p ) );
+            }
+            return polygons_offset;
+        }
+
+        geode::AttributeManager& vtk_cell_attribute_manager() override
+        {
+            return mesh().polygon_attribute_manager();
+        }
+
+        void compute_vtk_cell_adjacencies() override
+        {
+            builder().compute_polygon_adjacencies();
+        }
+
+        bool set_vtk_cell_adjacencies(
+            absl::Span< const int64_t > adjacencies,
+            geode::index_t nb_components ) override
+        {
+            return geode::detail::set_vtk_polygon_adjacencies< 3 >(
+                mesh(), builder(), adjacencies, nb_components );
         }
 
         geode::Percentage is_vtk_cells_loadable(
             const pugi::xml_node& piece ) const override
         {
+            // Any polygon can be loaded: polygon values are only decoded by
+            // the read itself
             const auto nb_polygons = read_attribute( piece, "NumberOfPolys" );
-            read_polygons( piece, nb_polygons );
+            if( nb_polygons > 0 && !piece.child( "Polys" ) )
+            {
+                return geode::Percentage{ 0 };
+            }
             return geode::Percentage{ 1 };
         }
 
-        absl::FixedArray< std::vector< geode::index_t > > read_polygons(
+        geode::detail::VTKCells read_polygons(
             const pugi::xml_node& piece, geode::index_t nb_polygons ) const
         {
-            std::vector< int64_t > offsets_values;
-            std::vector< int64_t > connectivity_values;
+            std::vector< geode::index_t > offsets_values;
+            std::vector< geode::index_t > connectivity_values;
             for( const auto& data :
                 piece.child( "Polys" ).children( "DataArray" ) )
             {
                 if( match( data.attribute( "Name" ).value(), "offsets" ) )
                 {
-                    offsets_values = read_integer_data_array< int64_t >( data );
+                    offsets_values = read_data_array< geode::index_t >( data );
                     geode::OpenGeodeIOMeshException::check_assertion(
                         offsets_values.size() == nb_polygons, nullptr,
                         geode::OpenGeodeException::TYPE::data,
@@ -79,25 +117,11 @@ namespace
                              "connectivity" ) )
                 {
                     connectivity_values =
-                        read_integer_data_array< int64_t >( data );
+                        read_data_array< geode::index_t >( data );
                 }
             }
-            return get_cell_vertices( connectivity_values, offsets_values );
-        }
-
-        geode::index_t build_polygons(
-            absl::Span< const std::vector< geode::index_t > > polygon_vertices )
-        {
-            absl::FixedArray< geode::index_t > new_polygons(
-                polygon_vertices.size() );
-            std::iota( new_polygons.begin(), new_polygons.end(),
-                mesh().nb_polygons() );
-            for( const auto& pv : polygon_vertices )
-            {
-                builder().create_polygon( pv );
-            }
-            builder().compute_polygon_adjacencies();
-            return new_polygons[0];
+            return get_cell_vertices(
+                std::move( connectivity_values ), std::move( offsets_values ) );
         }
     };
 } // namespace
@@ -44,49 +44,32 @@ namespace
         }
 
     private:
-        void append_number_elements( pugi::xml_node& piece ) override
+        void append_number_elements() override
         {
-            piece.append_attribute( "NumberOfVerts" )
-                .set_value( this->mesh().nb_vertices() );
+            this->xml().add_attribute(
+                "NumberOfVerts", this->mesh().nb_vertices() );
         }
 
-        pugi::xml_node write_vtk_cells( pugi::xml_node& piece ) override
+        void write_vtk_cells() override
         {
-            auto verts = piece.append_child( "Verts" );
-            auto connectivity = verts.append_child( "DataArray" );
-            connectivity.append_attribute( "type" ).set_value( "Int64" );
-            connectivity.append_attribute( "Name" ).set_value( "connectivity" );
-            connectivity.append_attribute( "format" ).set_value( "ascii" );
-            connectivity.append_attribute( "RangeMin" ).set_value( 0 );
-            connectivity.append_attribute( "RangeMax" )
-                .set_value( this->mesh().nb_vertices() - 1 );
-            auto offsets = verts.append_child( "DataArray" );
-            offsets.append_attribute( "type" ).set_value( "Int64" );
-            offsets.append_attribute( "Name" ).set_value( "offsets" );
-            offsets.append_attribute( "format" ).set_value( "ascii" );
-            offsets.append_attribute( "RangeMin" ).set_value( 0 );
-            offsets.append_attribute( "RangeMax" )
-                .set_value( this->mesh().nb_vertices() );
             const auto nb_vertices = this->mesh().nb_vertices();
-            std::string vertex_connectivity;
+            std::vector< int64_t > vertex_connectivity;
             vertex_connectivity.reserve( nb_vertices );
-            std::string vertex_offsets;
+            std::vector< int64_t > vertex_offsets;
             vertex_offsets.reserve( nb_vertices );
             for( const auto v : geode::Range{ nb_vertices } )
             {
-                absl::StrAppend( &vertex_offsets, v + 1, " " );
-                absl::StrAppend( &vertex_connectivity, v, " " );
+                vertex_offsets.push_back( v + 1 );
+                vertex_connectivity.push_back( v );
             }
-            connectivity.text().set( vertex_connectivity.c_str() );
-            offsets.text().set( vertex_offsets.c_str() );
-            return verts;
+            auto& xml = this->xml();
+            xml.start_element( "Verts" );
+            this->write_index_data_array( "connectivity", vertex_connectivity );
+            this->write_index_data_array( "offsets", vertex_offsets );
+            xml.end_element();
         }
 
-        pugi::xml_node write_vtk_cell_attributes(
-            pugi::xml_node& /*unsued*/ ) override
-        {
-            return {};
-        }
+        void write_vtk_cell_attributes() override {}
     };
 } // namespace
 
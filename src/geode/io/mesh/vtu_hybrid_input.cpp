@@ -47,6 +47,14 @@ namespace
             enable_prism();
             enable_pyramid();
         }
+
+    private:
+        PieceReader create_piece_reader(
+            std::string_view filename ) const override
+        {
+            return std::make_unique< VTUHybridInputImpl >(
+                filename, mesh_impl() );
+        }
     };
 } // namespace
 
@@ -25,6 +25,8 @@
 
 #include <string>
 
+#include <absl/strings/match.h>
+
 #include <geode/mesh/core/hybrid_solid.hpp>
 
 #include <geode/io/mesh/detail/vtu_output_impl.hpp>
@@ -41,11 +43,19 @@ namespace
         {
         }
 
+        VTUHybridOutputImpl( std::string_view filename,
+            const geode::HybridSolid3D& solid,
+            std::vector< geode::index_t > polyhedra )
+            : geode::detail::VTUOutputImpl< geode::HybridSolid >{ filename,
+                  solid, std::move( polyhedra ) }
+        {
+        }
+
     private:
         void write_cell( geode::index_t p,
-            std::string& cell_types,
-            std::string& /*unused*/,
-            std::string& /*unused*/,
+            std::vector< uint8_t >& cell_types,
+            std::vector< int64_t >& /*unused*/,
+            std::vector< int64_t >& /*unused*/,
             geode::index_t& /*unused*/ ) const override
         {
             const auto nb_vertices = this->mesh().nb_polyhedron_vertices( p );
@@ -55,7 +65,7 @@ namespace
                 nullptr, geode::OpenGeodeException::TYPE::data,
                 "[VTUHybridOutputImpl::write_vtk_cell] Polyhedron with ",
                 nb_vertices, " vertices not supported" );
-            absl::StrAppend( &cell_types, vtk_type, " " );
+            cell_types.push_back( vtk_type );
         }
     };
 } // namespace
@@ -67,6 +77,11 @@ namespace geode
         std::vector< std::string > VTUHybridOutput::write(
             const HybridSolid3D& solid ) const
         {
+            if( absl::EndsWith( filename(), partitioned_extension() ) )
+            {
+                return write_pvtu_file< VTUHybridOutputImpl >(
+                    filename(), solid );
+            }
             VTUHybridOutputImpl impl{ filename(), solid };
             impl.write_file();
             return { to_string( filename() ) };
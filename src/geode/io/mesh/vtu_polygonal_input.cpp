@@ -45,6 +45,14 @@ namespace
             enable_triangle();
             enable_quad();
         }
+
+    private:
+        PieceReader create_piece_reader(
+            std::string_view filename ) const override
+        {
+            return std::make_unique< VTUPolygonalInputImpl >(
+                filename, mesh_impl() );
+        }
     };
 } // namespace
 
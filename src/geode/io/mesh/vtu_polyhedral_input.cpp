@@ -46,6 +46,15 @@ namespace
             enable_hexahedron();
             enable_prism();
             enable_pyramid();
+            enable_polyhedron();
+        }
+
+    private:
+        PieceReader create_piece_reader(
+            std::string_view filename ) const override
+        {
+            return std::make_unique< VTUPolyhedralInputImpl >(
+                filename, mesh_impl() );
         }
     };
 } // namespace
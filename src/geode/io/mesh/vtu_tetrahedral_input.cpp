@@ -34,8 +34,6 @@ namespace
     class VTUTetrahedralInputImpl
         : public geode::detail::VTUSolidInput< geode::TetrahedralSolid3D >
     {
-        using VTKElement = absl::FixedArray< std::vector< geode::index_t > >;
-
     public:
         VTUTetrahedralInputImpl(
             std::string_view filename, const geode::MeshImpl& impl )
@@ -44,6 +42,37 @@ namespace
         {
             enable_tetrahedron();
         }
+
+    private:
+        PieceReader create_piece_reader(
+            std::string_view filename ) const override
+        {
+            return std::make_unique< VTUTetrahedralInputImpl >(
+                filename, mesh_impl() );
+        }
+
+        void create_polyhedra( const geode::detail::VTKCells& cells,
+            geode::index_t begin,
+            geode::index_t end,
+            const VTKElement& /*unused*/ ) override
+        {
+            const auto first = builder().create_tetrahedra( end - begin );
+            for( const auto c : geode::Range{ begin, end } )
+            {
+                const auto vertices = cells.cell_vertices( c );
+                geode::OpenGeodeIOMeshException::check_exception(
+                    vertices.size() == 4, nullptr,
+                    geode::OpenGeodeException::TYPE::data,
+                    "[VTUTetrahedralInput::create_polyhedra] Tetrahedron ", c,
+                    " should have 4 vertices" );
+                const auto tetrahedron = first + c - begin;
+                for( const auto v : geode::LRange{ 4 } )
+                {
+                    builder().set_polyhedron_vertex(
+                        { tetrahedron, v }, vertices[v] );
+                }
+            }
+        }
     };
 } // namespace
 
@@ -25,6 +25,8 @@
 
 #include <string>
 
+#include <absl/strings/match.h>
+
 #include <geode/mesh/core/tetrahedral_solid.hpp>
 
 #include <geode/io/mesh/detail/vtu_output_impl.hpp>
@@ -42,14 +44,22 @@ namespace
         {
         }
 
+        VTUTetrahedralOutputImpl( std::string_view filename,
+            const geode::TetrahedralSolid3D& solid,
+            std::vector< geode::index_t > polyhedra )
+            : geode::detail::VTUOutputImpl< geode::TetrahedralSolid >{ filename,
+                  solid, std::move( polyhedra ) }
+        {
+        }
+
     private:
         void write_cell( geode::index_t /*unused*/,
-            std::string& cell_types,
-            std::string& /*unused*/,
-            std::string& /*unused*/,
+            std::vector< uint8_t >& cell_types,
+            std::vector< int64_t >& /*unused*/,
+            std::vector< int64_t >& /*unused*/,
             geode::index_t& /*unused*/ ) const override
         {
-            absl::StrAppend( &cell_types, "10 " );
+            cell_types.push_back( geode::detail::VTK_TETRAHEDRON_TYPE );
         }
     };
 } // namespace
@@ -61,6 +71,11 @@ namespace geode
         std::vector< std::string > VTUTetrahedralOutput::write(
             const TetrahedralSolid3D& solid ) const
         {
+            if( absl::EndsWith( filename(), partitioned_extension() ) )
+            {
+                return write_pvtu_file< VTUTetrahedralOutputImpl >(
+                    filename(), solid );
+            }
             VTUTetrahedralOutputImpl impl{ filename(), solid };
             impl.write_file();
             return { to_string( filename() ) };
@@ -44,6 +44,44 @@ namespace
         {
             enable_triangle();
         }
+
+    private:
+        PieceReader create_piece_reader(
+            std::string_view filename ) const override
+        {
+            return std::make_unique< VTUTriangulatedInputImpl >(
+                filename, mesh_impl() );
+        }
+
+        void create_polygons( const geode::detail::VTKCells& cells,
+            geode::index_t begin,
+            geode::index_t end,
+            geode::local_index_t nb_vertices ) override
+        {
+            geode::index_t nb_triangles{ 0 };
+            for( const auto c : geode::Range{ begin, end } )
+            {
+                if( cells.nb_cell_vertices( c ) == nb_vertices )
+                {
+                    nb_triangles++;
+                }
+            }
+            auto triangle = builder().create_triangles( nb_triangles );
+            for( const auto c : geode::Range{ begin, end } )
+            {
+                if( cells.nb_cell_vertices( c ) != nb_vertices )
+                {
+                    continue;
+                }
+                const auto vertices = cells.cell_vertices( c );
+                for( const auto v : geode::LRange{ 3 } )
+                {
+                    builder().set_polygon_vertex(
+                        { triangle, v }, vertices[v] );
+                }
+                triangle++;
+            }
+        }
     };
 } // namespace
 
@@ -42,6 +42,8 @@
 #include <geode/model/mixin/core/surface.hpp>
 #include <geode/model/representation/core/brep.hpp>
 
+#include <geode/io/image/detail/text_writer.hpp>
+
 namespace
 {
     constexpr auto FRACSIMA_ATTRIBUTE_NAME = "material_number";
@@ -74,9 +76,11 @@ namespace
     {
     public:
         GIDOutputImpl( std::string_view filename, const geode::BRep& brep )
-            : file_{ geode::to_string( filename ) }, brep_( brep )
+            : stream_{ geode::to_string( filename ) },
+              file_{ stream_ },
+              brep_( brep )
         {
-            geode::OpenGeodeIOModelException::check_exception( file_.good(),
+            geode::OpenGeodeIOModelException::check_exception( stream_.good(),
                 nullptr, geode::OpenGeodeException::TYPE::data,
                 "[GIDOutput] Error while opening file: ", filename );
         }
@@ -89,6 +93,7 @@ namespace
             write_header_surfaces();
             write_triangles_nodes();
             write_triangles( nb_tet );
+            file_.flush();
         }
 
     private:
@@ -116,7 +121,6 @@ namespace
                         file_ << brep_.block( cmv.component_id.id() )
                                      .mesh()
                                      .point( cmv.vertex )
-                                     .string()
                               << geode::EOL;
                         break;
                     }
@@ -199,7 +203,6 @@ namespace
                     file_ << brep_.surface( cmv.component_id.id() )
                                  .mesh()
                                  .point( cmv.vertex )
-                                 .string()
                           << geode::EOL;
                     break;
                 }
@@ -235,7 +238,8 @@ namespace
         }
 
     private:
-        std::ofstream file_;
+        std::ofstream stream_;
+        geode::detail::TextWriter file_;
         const geode::BRep& brep_;
     };
 } // namespace
@@ -58,6 +58,8 @@
 #include <geode/model/representation/builder/brep_builder.hpp>
 #include <geode/model/representation/core/brep.hpp>
 
+#include <geode/io/mesh/mesh_input_options.hpp>
+
 #include <geode/io/model/common.hpp>
 #include <geode/io/model/internal/msh_common.hpp>
 
@@ -69,7 +71,10 @@ namespace
         MSHInputImpl( std::string_view filename, geode::BRep& brep )
             : file_{ geode::to_string( filename ) },
               brep_( brep ),
-              builder_{ brep }
+              builder_{ brep },
+              compute_adjacencies_{
+                  geode::mesh_input_options().compute_adjacencies
+              }
         {
             geode::OpenGeodeIOModelException::check_exception( file_.good(),
                 nullptr, geode::OpenGeodeException::TYPE::data,
@@ -637,6 +642,10 @@ namespace
                         v, nodes_[brep_.unique_vertex(
                                { surface.component_id(), v } )] );
                 }
+                if( !compute_adjacencies_ )
+                {
+                    continue;
+                }
                 surface_builder->compute_polygon_adjacencies();
                 std::vector< geode::PolygonEdge > polygon_edges;
                 for( const auto& line : brep_.internal_lines( surface ) )
@@ -699,7 +708,10 @@ namespace
                         v, nodes_[brep_.unique_vertex(
                                { b.component_id(), v } )] );
                 }
-                block_builder->compute_polyhedron_adjacencies();
+                if( compute_adjacencies_ )
+                {
+                    block_builder->compute_polyhedron_adjacencies();
+                }
             }
         }
 
@@ -899,6 +911,7 @@ namespace
         std::ifstream file_;
         geode::BRep& brep_;
         geode::BRepBuilder builder_;
+        bool compute_adjacencies_;
         bool binary_{ true };
         double version_{ 2 };
         std::vector< std::string > sections_;
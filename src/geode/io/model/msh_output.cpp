@@ -45,6 +45,8 @@
 #include <geode/model/mixin/core/surface.hpp>
 #include <geode/model/representation/core/brep.hpp>
 
+#include <geode/io/image/detail/text_writer.hpp>
+
 #include <geode/io/model/common.hpp>
 #include <geode/io/model/internal/msh_common.hpp>
 
@@ -56,9 +58,11 @@ namespace
     {
     public:
         MSHOutputImpl( std::string_view filename, const geode::BRep& brep )
-            : file_{ geode::to_string( filename ) }, brep_( brep )
+            : stream_{ geode::to_string( filename ) },
+              file_{ stream_ },
+              brep_( brep )
         {
-            geode::OpenGeodeIOModelException::check_exception( file_.good(),
+            geode::OpenGeodeIOModelException::check_exception( stream_.good(),
                 nullptr, geode::OpenGeodeException::TYPE::data,
                 "[MSHOutput] Error while opening file: ", filename );
         }
@@ -69,6 +73,7 @@ namespace
             write_entities();
             write_nodes();
             write_elements();
+            file_.flush();
         }
 
     private:
@@ -109,9 +114,9 @@ namespace
             const Component& component, geode::index_t gmsh_id )
         {
             const auto bbox = component.mesh().bounding_box();
-            file_ << gmsh_id << geode::SPACE << bbox.min().string()
-                  << geode::SPACE << bbox.max().string() << geode::SPACE
-                  << DEFAULT_PHYSICAL_TAG << geode::SPACE;
+            file_ << gmsh_id << geode::SPACE << bbox.min() << geode::SPACE
+                  << bbox.max() << geode::SPACE << DEFAULT_PHYSICAL_TAG
+                  << geode::SPACE;
             file_ << brep_.nb_boundaries( component.id() );
             for( const auto& boundary : brep_.boundaries( component ) )
             {
@@ -129,7 +134,7 @@ namespace
             for( const auto& corner : brep_.corners() )
             {
                 const auto& point = corner.mesh().point( 0 );
-                file_ << count << geode::SPACE << point.string() << geode::SPACE
+                file_ << count << geode::SPACE << point << geode::SPACE
                       << DEFAULT_PHYSICAL_TAG << geode::EOL;
                 uuid2gmsh_[corner.id()] =
                     geode::internal::GmshElementID{ corner.component_type(),
@@ -152,9 +157,9 @@ namespace
             for( const auto& surface : brep_.surfaces() )
             {
                 const auto bbox = surface.mesh().bounding_box();
-                file_ << count << geode::SPACE << bbox.min().string()
-                      << geode::SPACE << bbox.max().string() << geode::SPACE
-                      << DEFAULT_PHYSICAL_TAG << geode::SPACE;
+                file_ << count << geode::SPACE << bbox.min() << geode::SPACE
+                      << bbox.max() << geode::SPACE << DEFAULT_PHYSICAL_TAG
+                      << geode::SPACE;
                 file_ << brep_.nb_boundaries( surface.id() )
                              + ( 2 * brep_.nb_internal_lines( surface ) );
                 for( const auto& boundary : brep_.boundaries( surface ) )
@@ -181,9 +186,9 @@ namespace
             for( const auto& block : brep_.blocks() )
             {
                 const auto bbox = block.mesh().bounding_box();
-                file_ << count << geode::SPACE << bbox.min().string()
-                      << geode::SPACE << bbox.max().string() << geode::SPACE
-                      << DEFAULT_PHYSICAL_TAG << geode::SPACE;
+                file_ << count << geode::SPACE << bbox.min() << geode::SPACE
+                      << bbox.max() << geode::SPACE << DEFAULT_PHYSICAL_TAG
+                      << geode::SPACE;
                 file_ << brep_.nb_boundaries( block.id() )
                              + ( 2 * brep_.nb_internal_surfaces( block ) );
                 for( const auto& boundary : brep_.boundaries( block ) )
@@ -233,7 +238,7 @@ namespace
             }
             for( const auto& vertex_pair : nodes_to_export )
             {
-                file_ << component.mesh().point( vertex_pair.first ).string()
+                file_ << component.mesh().point( vertex_pair.first )
                       << geode::EOL;
             }
         }
@@ -421,7 +426,8 @@ namespace
         }
 
     private:
-        std::ofstream file_;
+        std::ofstream stream_;
+        geode::detail::TextWriter file_;
         const geode::BRep& brep_;
         absl::flat_hash_map< geode::uuid, geode::internal::GmshElementID >
             uuid2gmsh_;
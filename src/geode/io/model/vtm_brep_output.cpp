@@ -59,16 +59,15 @@ namespace
         }
 
     private:
-        void write_piece( pugi::xml_node& object ) final
+        void write_piece() final
         {
-            const auto counter = this->write_corners_lines_surfaces( object );
-            auto block_block = object.append_child( "Block" );
-            block_block.append_attribute( "name" ).set_value( "blocks" );
-            block_block.append_attribute( "index" ).set_value( counter );
-            write_blocks( block_block );
+            const auto counter = this->write_corners_lines_surfaces();
+            this->start_block( "blocks", counter );
+            write_blocks();
+            this->xml().end_element();
         }
 
-        void write_blocks( pugi::xml_node& block_block )
+        void write_blocks()
         {
             geode::index_t counter{ 0 };
             const auto level = geode::Logger::level();
@@ -86,26 +85,13 @@ namespace
             for( const auto& id : block_ids )
             {
                 const auto& block = mesh().block( id );
-                auto dataset = block_block.append_child( "DataSet" );
-                dataset.append_attribute( "index" ).set_value( counter );
-                const auto filename = absl::StrCat(
-                    prefix(), "/Block_", block.id().string(), ".vtu" );
-                dataset.append_attribute( "file" ).set_value(
-                    filename.c_str() );
                 const auto name = block.name().value_or( block.id().string() );
                 const auto [_, is_new] = block_name_counter.emplace( name );
-                if( is_new )
-                {
-                    dataset.append_attribute( "name" ).set_value(
-                        name.c_str() );
-                }
-                else
-                {
-                    dataset.append_attribute( "name" ).set_value(
-                        absl::StrCat( name, "_", counter ).c_str() );
-                }
-                dataset.append_attribute( "uuid" ).set_value(
-                    block.id().string().c_str() );
+                write_dataset( counter,
+                    is_new ? name : absl::StrCat( name, "_", counter ),
+                    block.id(),
+                    absl::StrCat(
+                        prefix(), "/Block_", block.id().string(), ".vtu" ) );
                 tasks[counter++] = async::spawn( [&block, this] {
                     const auto& mesh = block.mesh();
                     const auto file = absl::StrCat(
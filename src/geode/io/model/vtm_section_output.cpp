@@ -44,9 +44,9 @@ namespace
         }
 
     private:
-        void write_piece( pugi::xml_node& object ) final
+        void write_piece() final
         {
-            this->write_corners_lines_surfaces( object );
+            this->write_corners_lines_surfaces();
         }
     };
 } // namespace
@@ -21,6 +21,8 @@
  *
  */
 
+#include <fstream>
+
 #include <geode/tests_config.hpp>
 
 #include <geode/basic/assert.hpp>
@@ -40,6 +42,7 @@
 #include <geode/mesh/io/regular_grid_output.hpp>
 
 #include <geode/io/mesh/common.hpp>
+#include <geode/io/mesh/vti_mapped_arrays.hpp>
 
 void put_attributes_on_grid( const geode::Grid3D& grid )
 {
@@ -91,6 +94,136 @@ void test_regular_grid( const geode::RegularGrid3D& grid )
     geode::save_regular_grid( *reload_grid, "test2.vti" );
 }
 
+void test_mapped_arrays( const geode::RegularGrid3D& grid )
+{
+    geode::save_regular_grid( grid, "test_mapped.vti" );
+    // Small cache to go through block eviction
+    const geode::VTIMappedArrays arrays{ "test_mapped.vti", 4096 };
+    const auto cell_array = arrays.array_index( "CellData", "id" );
+    geode::OpenGeodeIOMeshException::test( cell_array != geode::NO_ID,
+        "[TEST] Cell array should be mapped." );
+    geode::OpenGeodeIOMeshException::test(
+        arrays.nb_elements( cell_array ) == grid.nb_cells(),
+        "[TEST] Wrong number of mapped cell values." );
+    for( const auto c : geode::Range{ grid.nb_cells() } )
+    {
+        geode::OpenGeodeIOMeshException::test(
+            arrays.value( cell_array, c ) == c,
+            "[TEST] Wrong mapped cell value ", c );
+    }
+    const auto vertex_array = arrays.array_index( "PointData", "id_vertex" );
+    geode::OpenGeodeIOMeshException::test( vertex_array != geode::NO_ID,
+        "[TEST] Vertex array should be mapped." );
+    for( const auto v : geode::Range{ grid.nb_grid_vertices() } )
+    {
+        geode::OpenGeodeIOMeshException::test(
+            arrays.value( vertex_array, v ) == v,
+            "[TEST] Wrong mapped vertex value ", v );
+    }
+
+    const auto mapped =
+        geode::load_mapped_regular_grid< 3 >( "test_mapped.vti", 4096 );
+    geode::OpenGeodeIOMeshException::test(
+        mapped.grid->nb_cells() == grid.nb_cells(),
+        "[TEST] Wrong number of cells with mapped arrays." );
+    // Every array is either an attribute of the grid or mapped by its view
+    for( const auto& name :
+        grid.cell_attribute_manager().attribute_names() )
+    {
+        const auto is_attribute =
+            mapped.grid->cell_attribute_manager().attribute_exists( name );
+        const auto is_mapped =
+            mapped.arrays->array_index( "CellData", name ) != geode::NO_ID;
+        geode::OpenGeodeIOMeshException::test( is_attribute != is_mapped,
+            "[TEST] Cell array ", name,
+            " should be either loaded or mapped." );
+    }
+    const auto mapped_array = mapped.arrays->array_index( "CellData", "id" );
+    geode::OpenGeodeIOMeshException::test( mapped_array != geode::NO_ID,
+        "[TEST] Cell array should be mapped by the loaded view." );
+    for( const auto c : geode::Range{ mapped.grid->nb_cells() } )
+    {
+        geode::OpenGeodeIOMeshException::test(
+            mapped.arrays->value( mapped_array, c ) == c,
+            "[TEST] Wrong cell value from the loaded view ", c );
+    }
+}
+
+void write_grid_piece( std::string_view filename,
+    std::string_view extent,
+    std::string_view cell_values,
+    std::string_view vertex_values )
+{
+    std::ofstream file{ geode::to_string( filename ) };
+    file << R"(<?xml version="1.0"?>
+<VTKFile type="ImageData" version="1.0" byte_order="LittleEndian">
+  <ImageData WholeExtent="0 2 0 1 0 1" Origin="1 2 3" Spacing="1 1 1">
+    <Piece Extent=")"
+         << extent << R"(">
+      <PointData>
+        <DataArray type="Float64" Name="x" format="ascii">)"
+         << vertex_values << R"(</DataArray>
+      </PointData>
+      <CellData>
+        <DataArray type="Float64" Name="id" format="ascii">)"
+         << cell_values << R"(</DataArray>
+      </CellData>
+    </Piece>
+  </ImageData>
+</VTKFile>
+)";
+}
+
+void test_partitioned_grid()
+{
+    // Two pieces of one cell, sharing the vertices of their interface
+    write_grid_piece( "grid_0.vti", "0 1 0 1 0 1", "0", "0 1 0 1 0 1 0 1" );
+    write_grid_piece( "grid_1.vti", "1 2 0 1 0 1", "1", "1 2 1 2 1 2 1 2" );
+    {
+        std::ofstream file{ "grid.pvti" };
+        file << R"(<?xml version="1.0"?>
+<VTKFile type="PImageData" version="1.0" byte_order="LittleEndian">
+  <PImageData WholeExtent="0 2 0 1 0 1" GhostLevel="0" Origin="1 2 3"
+    Spacing="1 1 1">
+    <PPointData>
+      <PDataArray type="Float64" Name="x"/>
+    </PPointData>
+    <PCellData>
+      <PDataArray type="Float64" Name="id"/>
+    </PCellData>
+    <Piece Extent="0 1 0 1 0 1" Source="grid_0.vti"/>
+    <Piece Extent="1 2 0 1 0 1" Source="grid_1.vti"/>
+  </PImageData>
+</VTKFile>
+)";
+    }
+    const auto grid = geode::load_regular_grid< 3 >( "grid.pvti" );
+    geode::OpenGeodeIOMeshException::test(
+        grid->nb_cells() == 2 && grid->nb_grid_vertices() == 12,
+        "[TEST] Wrong number of elements of the partitioned grid." );
+    geode::OpenGeodeIOMeshException::test(
+        grid->grid_coordinate_system().origin().inexact_equal(
+            geode::Point3D{ { 1, 2, 3 } } ),
+        "[TEST] Wrong origin of the partitioned grid." );
+    const auto id =
+        grid->cell_attribute_manager().find_attribute< double >( "id" );
+    for( const auto i : geode::LRange{ 2 } )
+    {
+        geode::OpenGeodeIOMeshException::test(
+            id->value( grid->cell_index( { i, 0, 0 } ) ) == i,
+            "[TEST] Wrong cell value of piece ", i );
+    }
+    const auto x =
+        grid->grid_vertex_attribute_manager().find_attribute< double >( "x" );
+    for( const auto v : geode::Range{ grid->nb_grid_vertices() } )
+    {
+        const auto vertex = grid->vertex_indices( v );
+        geode::OpenGeodeIOMeshException::test(
+            x->value( v ) == vertex[0],
+            "[TEST] Wrong vertex value of the partitioned grid ", v );
+    }
+}
+
 void test_light_regular_grid( const geode::LightRegularGrid3D& grid )
 {
     geode::save_light_regular_grid( grid, "test3.vti" );
@@ -135,6 +268,8 @@ int main()
             geode::Point3D{ { 1, 2, 3 } }, { 10, 20, 30 }, 1 );
         put_attributes_on_grid( *grid );
         test_regular_grid( *grid );
+        test_mapped_arrays( *grid );
+        test_partitioned_grid();
 
         geode::LightRegularGrid3D lgrid{ geode::Point3D{ { 1, 2, 3 } },
             { 10, 20, 30 }, { 1, 1, 1 } };
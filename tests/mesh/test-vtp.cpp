@@ -21,17 +21,27 @@
  *
  */
 
+#include <fstream>
+
 #include <geode/tests_config.hpp>
 
 #include <geode/basic/assert.hpp>
 #include <geode/basic/attribute_manager.hpp>
 #include <geode/basic/logger.hpp>
+#include <geode/basic/string.hpp>
+
+#include <geode/geometry/point.hpp>
+
+#include <geode/mesh/builder/polygonal_surface_builder.hpp>
 
 #include <geode/mesh/core/polygonal_surface.hpp>
 #include <geode/mesh/io/polygonal_surface_input.hpp>
 #include <geode/mesh/io/polygonal_surface_output.hpp>
 
 #include <geode/io/mesh/common.hpp>
+#include <geode/io/mesh/detail/vtk_ascii_values.hpp>
+#include <geode/io/mesh/vtk_data_arrays.hpp>
+#include <geode/io/mesh/vtk_input_options.hpp>
 
 void check( const geode::PolygonalSurface3D& surface,
     const std::array< geode::index_t, 2 >& test_answers,
@@ -97,6 +107,366 @@ void run_test( std::string_view filename,
         polygon_attributes );
 }
 
+class ScopedVTKInputOptions
+{
+public:
+    explicit ScopedVTKInputOptions( const geode::VTKInputOptions& options )
+    {
+        geode::set_vtk_input_options( options );
+    }
+
+    ~ScopedVTKInputOptions()
+    {
+        geode::set_vtk_input_options( {} );
+    }
+};
+
+void run_attribute_filter_test()
+{
+    const auto file = absl::StrCat( geode::DATA_PATH, "dfn1_ascii.vtp" );
+    const auto data_arrays = geode::vtk_data_arrays( file );
+    geode::OpenGeodeIOMeshException::test( data_arrays.size() == 4,
+        "Number of listed data arrays is not correct: should be 4, get ",
+        data_arrays.size() );
+
+    geode::VTKInputOptions options;
+    options.attribute_filter = []( std::string_view name ) {
+        return name == "FractureId";
+    };
+    const auto surface = [&] {
+        const ScopedVTKInputOptions scoped_options{ options };
+        return geode::load_polygonal_surface< 3 >( file );
+    }();
+    check( *surface, { 187, 10 }, {}, { "FractureId" } );
+    geode::OpenGeodeIOMeshException::test(
+        !surface->polygon_attribute_manager().attribute_exists(
+            "FractureArea" ),
+        "Attribute FractureArea should not be loaded" );
+}
+
+void write_two_pieces_file( std::string_view filename )
+{
+    std::ofstream file{ geode::to_string( filename ) };
+    file << R"(<?xml version="1.0"?>
+<VTKFile type="PolyData" version="1.0" byte_order="LittleEndian">
+  <PolyData>
+    <Piece NumberOfPoints="3" NumberOfPolys="1">
+      <Points>
+        <DataArray type="Float32" NumberOfComponents="3" format="ascii">
+          0 0 0 1 0 0 0 1 0
+        </DataArray>
+      </Points>
+      <CellData>
+        <DataArray type="Float64" Name="piece" format="ascii">0</DataArray>
+        <DataArray type="UInt8" Name="region" RangeMin="2" RangeMax="2"
+          format="ascii">2</DataArray>
+      </CellData>
+      <Polys>
+        <DataArray type="Int32" Name="connectivity" format="ascii">
+          0 1 2
+        </DataArray>
+        <DataArray type="Int32" Name="offsets" format="ascii">3</DataArray>
+      </Polys>
+    </Piece>
+    <Piece NumberOfPoints="4" NumberOfPolys="1">
+      <Points>
+        <DataArray type="Float64" NumberOfComponents="3" format="ascii">
+          0 0 1 1 0 1 1 1 1 0 1 1
+        </DataArray>
+      </Points>
+      <PointData>
+        <DataArray type="Float64" Name="height" format="ascii">
+          1 1 1 1
+        </DataArray>
+      </PointData>
+      <CellData>
+        <DataArray type="Float64" Name="piece" format="ascii">+1</DataArray>
+        <DataArray type="Int32" Name="region" format="ascii">-1</DataArray>
+      </CellData>
+      <Polys>
+        <DataArray type="Int64" Name="connectivity" format="ascii">
+          0 +1 2 3
+        </DataArray>
+        <DataArray type="Int64" Name="offsets" format="ascii">4</DataArray>
+      </Polys>
+    </Piece>
+  </PolyData>
+</VTKFile>
+)";
+}
+
+void check_two_pieces( const geode::PolygonalSurface3D& surface )
+{
+    check( surface, { 7, 2 }, { "height" }, { "piece", "region" } );
+    geode::OpenGeodeIOMeshException::test(
+        surface.polygon_vertex( { 1, 0 } ) == 3
+            && surface.polygon_vertex( { 1, 3 } ) == 6,
+        "Second piece polygon should use second piece vertices" );
+    const auto attribute =
+        surface.polygon_attribute_manager().find_attribute< double >(
+            "piece" );
+    geode::OpenGeodeIOMeshException::test(
+        attribute->value( 0 ) == 0 && attribute->value( 1 ) == 1,
+        "Piece attribute values are not correct" );
+    // Unsigned and signed pieces of an attribute are read as signed
+    const auto region =
+        surface.polygon_attribute_manager().find_attribute< long int >(
+            "region" );
+    geode::OpenGeodeIOMeshException::test(
+        region->value( 0 ) == 2 && region->value( 1 ) == -1,
+        "Region attribute values are not correct" );
+}
+
+void run_multi_pieces_test()
+{
+    const auto filename = "two_pieces.vtp";
+    write_two_pieces_file( filename );
+    // Arrays of every piece are listed, not only the first one
+    const auto data_arrays = geode::vtk_data_arrays( filename );
+    geode::OpenGeodeIOMeshException::test( data_arrays.size() == 3,
+        "Number of listed data arrays is not correct: should be 3, get ",
+        data_arrays.size() );
+    check_two_pieces( *geode::load_polygonal_surface< 3 >( filename ) );
+
+    geode::VTKInputOptions options;
+    options.parallel_pieces = false;
+    const ScopedVTKInputOptions scoped_options{ options };
+    check_two_pieces( *geode::load_polygonal_surface< 3 >( filename ) );
+}
+
+void write_surface_piece( std::string_view filename,
+    std::string_view points,
+    double piece )
+{
+    std::ofstream file{ geode::to_string( filename ) };
+    file << R"(<?xml version="1.0"?>
+<VTKFile type="PolyData" version="1.0" byte_order="LittleEndian">
+  <PolyData>
+    <Piece NumberOfPoints="3" NumberOfPolys="1">
+      <PointData>
+        <DataArray type="Float64" Name="height" format="ascii">)"
+         << piece << " " << piece << " " << piece << R"(</DataArray>
+      </PointData>
+      <CellData>
+        <DataArray type="Float64" Name="piece" format="ascii">)"
+         << piece << R"(</DataArray>
+      </CellData>
+      <Points>
+        <DataArray type="Float64" NumberOfComponents="3" format="ascii">)"
+         << points << R"(</DataArray>
+      </Points>
+      <Polys>
+        <DataArray type="Int32" Name="connectivity" format="ascii">
+          0 1 2
+        </DataArray>
+        <DataArray type="Int32" Name="offsets" format="ascii">3</DataArray>
+      </Polys>
+    </Piece>
+  </PolyData>
+</VTKFile>
+)";
+}
+
+void run_partitioned_test()
+{
+    // Two triangles sharing an edge, whose vertices are merged
+    write_surface_piece( "surface_0.vtp", "0 0 0 1 0 0 0 1 0", 0 );
+    write_surface_piece( "surface_1.vtp", "1 0 0 1 1 0 0 1 0", 1 );
+    const auto filename = "surface.pvtp";
+    {
+        std::ofstream file{ filename };
+        file << R"(<?xml version="1.0"?>
+<VTKFile type="PPolyData" version="1.0" byte_order="LittleEndian">
+  <PPolyData GhostLevel="0">
+    <PPointData>
+      <PDataArray type="Float64" Name="height"/>
+    </PPointData>
+    <PCellData>
+      <PDataArray type="Float64" Name="piece"/>
+    </PCellData>
+    <PPoints>
+      <PDataArray type="Float64" NumberOfComponents="3"/>
+    </PPoints>
+    <Piece Source="surface_0.vtp"/>
+    <Piece Source="surface_1.vtp"/>
+  </PPolyData>
+</VTKFile>
+)";
+    }
+    geode::OpenGeodeIOMeshException::test(
+        geode::is_polygonal_surface_loadable< 3 >( filename ).value() == 1,
+        "Partitioned file should be loadable" );
+    const auto surface = geode::load_polygonal_surface< 3 >( filename );
+    check( *surface, { 4, 2 }, { "height" }, { "piece" } );
+    geode::OpenGeodeIOMeshException::test(
+        surface->polygon_vertex( { 1, 0 } ) == 1
+            && surface->polygon_vertex( { 1, 1 } ) == 3
+            && surface->polygon_vertex( { 1, 2 } ) == 2,
+        "Second piece polygon should use the merged vertices" );
+    const auto piece =
+        surface->polygon_attribute_manager().find_attribute< double >(
+            "piece" );
+    geode::OpenGeodeIOMeshException::test(
+        piece->value( 0 ) == 0 && piece->value( 1 ) == 1,
+        "Piece attribute values are not correct" );
+    const auto height =
+        surface->vertex_attribute_manager().find_attribute< double >(
+            "height" );
+    geode::OpenGeodeIOMeshException::test(
+        height->value( 0 ) == 0 && height->value( 3 ) == 1,
+        "Height attribute values are not correct" );
+}
+
+void run_wrapped_base64_test()
+{
+    // Binary values wrapped on several lines, some groups being split
+    const auto filename = "wrapped_base64.vtp";
+    std::ofstream file{ filename };
+    file << R"(<?xml version="1.0"?>
+<VTKFile type="PolyData" version="1.0" byte_order="LittleEndian">
+  <PolyData>
+    <Piece NumberOfPoints="3" NumberOfPolys="1">
+      <Points>
+        <DataArray type="Float32" NumberOfComponents="3" format="binary">
+          JAAAAAAAAAAAAAAA
+          AAAAAAAAgD8AAAAA
+          AAAAAAAAAAAAAIA/
+          AAAAAA==
+        </DataArray>
+      </Points>
+      <CellData>
+        <DataArray type="Float64" Name="value" format="binary">
+          CAAAAA AAAA
+          AAA OA/
+        </DataArray>
+      </CellData>
+      <Polys>
+        <DataArray type="Int32" Name="connectivity" format="binary">
+          DAAAAAAAAAAB
+          AAAAAgAAAA==
+        </DataArray>
+        <DataArray type="Int32" Name="offsets" format="binary">
+          BAAAAAMAAAA=
+        </DataArray>
+      </Polys>
+    </Piece>
+  </PolyData>
+</VTKFile>
+)";
+    file.close();
+    const auto surface = geode::load_polygonal_surface< 3 >( filename );
+    check( *surface, { 3, 1 }, {}, { "value" } );
+    geode::OpenGeodeIOMeshException::test(
+        surface->point( 1 ) == geode::Point3D{ { 1, 0, 0 } }
+            && surface->point( 2 ) == geode::Point3D{ { 0, 1, 0 } },
+        "Wrapped base64 points are not correct" );
+    geode::OpenGeodeIOMeshException::test(
+        surface->polygon_vertex( { 0, 2 } ) == 2,
+        "Wrapped base64 connectivity is not correct" );
+    const auto value =
+        surface->polygon_attribute_manager().find_attribute< double >(
+            "value" );
+    geode::OpenGeodeIOMeshException::test( value->value( 0 ) == 0.5,
+        "Wrapped base64 attribute value is not correct" );
+}
+
+void run_large_ascii_test()
+{
+    // Points text is above the size parsed by concurrent chunks
+    constexpr geode::index_t nb_points{ 200000 };
+    std::string points;
+    for( const auto p : geode::Range{ nb_points } )
+    {
+        absl::StrAppend( &points, "+", p, " ", -static_cast< int >( p ),
+            " ", 3 * p, p % 5 == 0 ? "\n          " : "\t" );
+    }
+    geode::OpenGeodeIOMeshException::test(
+        points.size() > geode::detail::ASCII_VALUES_CHUNK_SIZE,
+        "Points text should be parsed by chunks" );
+    const auto filename = "large_ascii.vtp";
+    std::ofstream file{ filename };
+    file << R"(<?xml version="1.0"?>
+<VTKFile type="PolyData" version="1.0" byte_order="LittleEndian">
+  <PolyData>
+    <Piece NumberOfPoints=")"
+         << nb_points << R"(" NumberOfPolys="1">
+      <Points>
+        <DataArray type="Float64" NumberOfComponents="3" format="ascii">
+          )" << points
+         << R"(
+        </DataArray>
+      </Points>
+      <Polys>
+        <DataArray type="Int32" Name="connectivity" format="ascii">
+          0 1 2
+        </DataArray>
+        <DataArray type="Int32" Name="offsets" format="ascii">3</DataArray>
+      </Polys>
+    </Piece>
+  </PolyData>
+</VTKFile>
+)";
+    file.close();
+    const auto surface = geode::load_polygonal_surface< 3 >( filename );
+    check( *surface, { nb_points, 1 }, {}, {} );
+    std::vector< double > serial_values( 3 * nb_points );
+    geode::detail::parse_ascii_values< double >(
+        points, absl::MakeSpan( serial_values ) );
+    for( const auto p : geode::Range{ nb_points } )
+    {
+        const auto& point = surface->point( p );
+        for( const auto d : geode::LRange{ 3 } )
+        {
+            geode::OpenGeodeIOMeshException::test(
+                point.value( d ) == serial_values[3 * p + d],
+                "Point ", p, " read by chunks differs from serial parse" );
+        }
+    }
+    geode::OpenGeodeIOMeshException::test(
+        surface->point( nb_points - 1 )
+            == geode::Point3D{ { nb_points - 1., 1. - nb_points,
+                3. * ( nb_points - 1 ) } },
+        "Last point read by chunks is not correct" );
+}
+
+void run_typed_attributes_test()
+{
+    auto surface = geode::PolygonalSurface3D::create();
+    auto builder = geode::PolygonalSurfaceBuilder3D::create( *surface );
+    builder->create_point( geode::Point3D{ { 0, 0, 0 } } );
+    builder->create_point( geode::Point3D{ { 1, 0, 0 } } );
+    builder->create_point( geode::Point3D{ { 0, 1, 0 } } );
+    builder->create_polygon( { 0, 1, 2 } );
+    builder->create_polygon( { 2, 1, 0 } );
+    auto region =
+        surface->polygon_attribute_manager()
+            .find_or_create_attribute< geode::VariableAttribute, int >(
+                "region", 0 );
+    region->set_value( 0, -3 );
+    region->set_value( 1, 16777217 );
+    auto value =
+        surface->polygon_attribute_manager()
+            .find_or_create_attribute< geode::VariableAttribute, double >(
+                "value", 0 );
+    value->set_value( 1, 0.1 );
+    const auto filename = "typed_attributes.vtp";
+    geode::save_polygonal_surface( *surface, filename );
+
+    const auto reloaded = geode::load_polygonal_surface< 3 >( filename );
+    const auto reloaded_region =
+        reloaded->polygon_attribute_manager().find_attribute< long int >(
+            "region" );
+    geode::OpenGeodeIOMeshException::test(
+        reloaded_region->value( 0 ) == -3
+            && reloaded_region->value( 1 ) == 16777217,
+        "Integer attribute values are not exact after reloading" );
+    const auto reloaded_value =
+        reloaded->polygon_attribute_manager().find_attribute< double >(
+            "value" );
+    geode::OpenGeodeIOMeshException::test( reloaded_value->value( 1 ) == 0.1,
+        "Double attribute values are not exact after reloading" );
+}
+
 int main()
 {
     try
@@ -114,6 +484,12 @@ int main()
             { "Fracture Label", "Fracture size", "Triangle size", "Border" } );
         run_test( "dfn3.vtp", { 238819, 13032 }, { "FractureSize" },
             { "FractureId", "FractureSize", "FractureArea" } );
+        run_attribute_filter_test();
+        run_multi_pieces_test();
+        run_partitioned_test();
+        run_wrapped_base64_test();
+        run_large_ascii_test();
+        run_typed_attributes_test();
 
         geode::Logger::info( "TEST SUCCESS" );
         return 0;
@@ -21,23 +21,35 @@
  *
  */
 
+#include <fstream>
+#include <sstream>
+
+#include <absl/strings/match.h>
+#include <absl/strings/str_split.h>
+
 #include <geode/tests_config.hpp>
 
 #include <geode/basic/assert.hpp>
 #include <geode/basic/logger.hpp>
 
+#include <geode/mesh/builder/polyhedral_solid_builder.hpp>
+#include <geode/mesh/builder/tetrahedral_solid_builder.hpp>
 #include <geode/mesh/core/hybrid_solid.hpp>
 #include <geode/mesh/core/polyhedral_solid.hpp>
 #include <geode/mesh/core/tetrahedral_solid.hpp>
 #include <geode/mesh/core/triangulated_surface.hpp>
 #include <geode/mesh/io/hybrid_solid_input.hpp>
 #include <geode/mesh/io/polyhedral_solid_input.hpp>
+#include <geode/mesh/io/polyhedral_solid_output.hpp>
 #include <geode/mesh/io/tetrahedral_solid_input.hpp>
 #include <geode/mesh/io/tetrahedral_solid_output.hpp>
 #include <geode/mesh/io/triangulated_surface_input.hpp>
 #include <geode/mesh/io/triangulated_surface_output.hpp>
 
+#include <geode/io/image/vtk_output_options.hpp>
+
 #include <geode/io/mesh/common.hpp>
+#include <geode/io/mesh/mesh_input_options.hpp>
 
 void check( const geode::SolidMesh< 3 >& solid,
     const std::array< geode::index_t, 2 >& test_answers )
@@ -69,6 +81,200 @@ void check( const geode::SurfaceMesh< 3 >& surface,
         test_answers[1], ", get ", surface.nb_polygons() );
 }
 
+void check_adjacencies(
+    const geode::SolidMesh3D& solid, const geode::SolidMesh3D& reload )
+{
+    for( const auto p : geode::Range{ solid.nb_polyhedra() } )
+    {
+        for( const auto f : geode::LRange{ solid.nb_polyhedron_facets( p ) } )
+        {
+            geode::OpenGeodeIOMeshException::test(
+                reload.polyhedron_adjacent( { p, f } )
+                    == solid.polyhedron_adjacent( { p, f } ),
+                "Wrong adjacency of polyhedron ", p, " facet ", f );
+        }
+    }
+}
+
+/*!
+ * Set the VTK output options until the end of the scope, even if a check
+ * throws, so that later tests run with the default options
+ */
+class ScopedVTKOutputOptions
+{
+public:
+    explicit ScopedVTKOutputOptions( const geode::VTKOutputOptions& options )
+    {
+        geode::set_vtk_output_options( options );
+    }
+
+    ~ScopedVTKOutputOptions()
+    {
+        geode::set_vtk_output_options( {} );
+    }
+};
+
+class ScopedMeshInputOptions
+{
+public:
+    explicit ScopedMeshInputOptions( const geode::MeshInputOptions& options )
+    {
+        geode::set_mesh_input_options( options );
+    }
+
+    ~ScopedMeshInputOptions()
+    {
+        geode::set_mesh_input_options( {} );
+    }
+};
+
+void save_with_options( const geode::TetrahedralSolid3D& solid,
+    const geode::VTKOutputOptions& options,
+    std::string_view output_filename )
+{
+    const ScopedVTKOutputOptions scoped_options{ options };
+    geode::save_tetrahedral_solid( solid, output_filename );
+}
+
+void test_deferred_adjacencies( const geode::TetrahedralSolid3D& solid,
+    std::string_view filename,
+    const std::array< geode::index_t, 2 >& test_answers )
+{
+    geode::MeshInputOptions options;
+    options.compute_adjacencies = false;
+    const auto reload = [&] {
+        const ScopedMeshInputOptions scoped_options{ options };
+        return geode::load_tetrahedral_solid< 3 >( filename );
+    }();
+    check( *reload, test_answers );
+    for( const auto p : geode::Range{ reload->nb_polyhedra() } )
+    {
+        for( const auto f : geode::LRange{ 4 } )
+        {
+            geode::OpenGeodeIOMeshException::test(
+                !reload->polyhedron_adjacent( { p, f } ),
+                "Adjacencies should not be computed" );
+        }
+    }
+    geode::TetrahedralSolidBuilder3D::create( *reload )
+        ->compute_polyhedron_adjacencies();
+    check_adjacencies( solid, *reload );
+}
+
+void test_data_formats( const geode::TetrahedralSolid3D& solid,
+    std::string_view filename_without_ext,
+    const std::array< geode::index_t, 2 >& test_answers )
+{
+    for( const auto format :
+        { geode::VTK_DATA_FORMAT::ascii, geode::VTK_DATA_FORMAT::binary,
+            geode::VTK_DATA_FORMAT::base64_appended } )
+    {
+        for( const auto compressor :
+            { geode::VTK_COMPRESSOR::none, geode::VTK_COMPRESSOR::zlib } )
+        {
+            geode::VTKOutputOptions options;
+            options.format = format;
+            options.compressor = compressor;
+            const auto output_filename = absl::StrCat(
+                filename_without_ext, "_format", static_cast< int >( format ),
+                "_", static_cast< int >( compressor ), ".vtu" );
+            save_with_options( solid, options, output_filename );
+            check( *geode::load_hybrid_solid< 3 >( output_filename ),
+                test_answers );
+        }
+    }
+}
+
+void test_raw_data( const geode::TetrahedralSolid3D& solid,
+    std::string_view filename_without_ext,
+    const std::array< geode::index_t, 2 >& test_answers )
+{
+    geode::VTKOutputOptions options;
+    options.compressor = geode::VTK_COMPRESSOR::none;
+    const auto output_filename =
+        absl::StrCat( filename_without_ext, "_raw.vtu" );
+    save_with_options( solid, options, output_filename );
+    check( *geode::load_hybrid_solid< 3 >( output_filename ), test_answers );
+    geode::OpenGeodeIOMeshException::test(
+        geode::is_tetrahedral_solid_loadable< 3 >( output_filename ).value()
+            == 1,
+        "Raw file should be loadable" );
+}
+
+void test_compressors( const geode::TetrahedralSolid3D& solid,
+    std::string_view filename_without_ext,
+    const std::array< geode::index_t, 2 >& test_answers )
+{
+    for( const auto compressor : { geode::VTK_COMPRESSOR::zlib,
+             geode::VTK_COMPRESSOR::lz4, geode::VTK_COMPRESSOR::lzma } )
+    {
+        geode::VTKOutputOptions options;
+        options.compressor = compressor;
+        // Small blocks so that arrays span several blocks
+        options.compression_block_size = 256;
+        const auto output_filename =
+            absl::StrCat( filename_without_ext, "_compressed",
+                static_cast< int >( compressor ), ".vtu" );
+        save_with_options( solid, options, output_filename );
+        check(
+            *geode::load_hybrid_solid< 3 >( output_filename ), test_answers );
+    }
+}
+
+void test_value_sizes( const geode::TetrahedralSolid3D& solid,
+    std::string_view filename_without_ext,
+    const std::array< geode::index_t, 2 >& test_answers )
+{
+    // Int64 indices and Float32 geometry
+    geode::VTKOutputOptions options;
+    options.compact_indices = false;
+    options.single_precision = true;
+    const auto output_filename =
+        absl::StrCat( filename_without_ext, "_single.vtu" );
+    save_with_options( solid, options, output_filename );
+    check( *geode::load_hybrid_solid< 3 >( output_filename ), test_answers );
+}
+
+void test_stored_adjacencies( const geode::TetrahedralSolid3D& solid,
+    std::string_view filename_without_ext,
+    const std::array< geode::index_t, 2 >& test_answers )
+{
+    geode::VTKOutputOptions options;
+    options.adjacencies = true;
+    const auto output_filename =
+        absl::StrCat( filename_without_ext, "_adjacency.vtu" );
+    save_with_options( solid, options, output_filename );
+    const auto reload = geode::load_tetrahedral_solid< 3 >( output_filename );
+    check( *reload, test_answers );
+    check_adjacencies( solid, *reload );
+    geode::OpenGeodeIOMeshException::test(
+        !reload->polyhedron_attribute_manager().attribute_exists(
+            "geode_adjacency" ),
+        "Stored adjacencies should not be loaded as an attribute" );
+}
+
+void test_partitioned_file( const geode::TetrahedralSolid3D& solid,
+    std::string_view filename_without_ext,
+    const std::array< geode::index_t, 2 >& test_answers )
+{
+    geode::VTKOutputOptions options;
+    options.nb_pieces = 3;
+    const auto output_filename =
+        absl::StrCat( filename_without_ext, ".pvtu" );
+    save_with_options( solid, options, output_filename );
+    const auto reload = geode::load_tetrahedral_solid< 3 >( output_filename );
+    check( *reload, test_answers );
+    // Piece vertices are merged by their global ids
+    geode::OpenGeodeIOMeshException::test(
+        !reload->vertex_attribute_manager().attribute_exists(
+            "geode_global_ids" ),
+        "Global ids should not be loaded as an attribute" );
+    geode::OpenGeodeIOMeshException::test(
+        geode::is_tetrahedral_solid_loadable< 3 >( output_filename ).value()
+            == 1,
+        "Partitioned file should be loadable" );
+}
+
 void run_solid_test( std::string_view filename,
     const std::array< geode::index_t, 2 >& test_answers,
     double loadability )
@@ -98,6 +304,14 @@ void run_solid_test( std::string_view filename,
     auto reload_vtu = geode::load_hybrid_solid< 3 >( output_filename_vtu );
     check( *reload_vtu, test_answers );
 
+    test_deferred_adjacencies( *solid, output_filename_vtu, test_answers );
+    test_data_formats( *solid, filename_without_ext, test_answers );
+    test_raw_data( *solid, filename_without_ext, test_answers );
+    test_compressors( *solid, filename_without_ext, test_answers );
+    test_value_sizes( *solid, filename_without_ext, test_answers );
+    test_stored_adjacencies( *solid, filename_without_ext, test_answers );
+    test_partitioned_file( *solid, filename_without_ext, test_answers );
+
     geode::OpenGeodeIOMeshException::test(
         std::fabs( geode::is_tetrahedral_solid_loadable< 3 >( file ).value()
                    - loadability )
@@ -126,6 +340,96 @@ void run_surface_test( std::string_view filename,
         "File should be loadable" );
 }
 
+std::unique_ptr< geode::PolyhedralSolid3D > create_polyhedra()
+{
+    // Pentagonal prism, stored as a VTK_POLYHEDRON, and a tetrahedron
+    auto solid = geode::PolyhedralSolid< 3 >::create();
+    auto builder = geode::PolyhedralSolidBuilder< 3 >::create( *solid );
+    for( const auto z : { 0., 1. } )
+    {
+        builder->create_point( geode::Point3D{ { 0, 0, z } } );
+        builder->create_point( geode::Point3D{ { 1, 0, z } } );
+        builder->create_point( geode::Point3D{ { 1.5, 1, z } } );
+        builder->create_point( geode::Point3D{ { 0.5, 2, z } } );
+        builder->create_point( geode::Point3D{ { -0.5, 1, z } } );
+    }
+    builder->create_point( geode::Point3D{ { 0.5, 1, 2 } } );
+    const std::vector< geode::index_t > prism_vertices{ 0, 1, 2, 3, 4, 5,
+        6, 7, 8, 9 };
+    const std::vector< std::vector< geode::local_index_t > > prism_facets{
+        { 0, 4, 3, 2, 1 }, { 5, 6, 7, 8, 9 }, { 0, 1, 6, 5 }, { 1, 2, 7, 6 },
+        { 2, 3, 8, 7 }, { 3, 4, 9, 8 }, { 4, 0, 5, 9 }
+    };
+    builder->create_polyhedron( prism_vertices, prism_facets );
+    const std::vector< geode::index_t > tetrahedron_vertices{ 5, 6, 7, 10 };
+    const std::vector< std::vector< geode::local_index_t > >
+        tetrahedron_facets{ { 1, 3, 2 }, { 0, 2, 3 }, { 3, 1, 0 },
+            { 0, 1, 2 } };
+    builder->create_polyhedron( tetrahedron_vertices, tetrahedron_facets );
+    return solid;
+}
+
+std::string data_array_text( std::string_view filename, std::string_view name )
+{
+    std::ifstream file{ geode::to_string( filename ) };
+    std::stringstream stream;
+    stream << file.rdbuf();
+    const auto content = stream.str();
+    const auto array = content.find( absl::StrCat( "Name=\"", name, "\"" ) );
+    geode::OpenGeodeIOMeshException::test( array != std::string::npos,
+        "DataArray ", name, " should be written" );
+    const auto start = content.find( '>', array ) + 1;
+    return content.substr( start, content.find( '<', start ) - start );
+}
+
+void test_polyhedron_face_offsets( const geode::PolyhedralSolid3D& solid )
+{
+    geode::VTKOutputOptions options;
+    options.format = geode::VTK_DATA_FORMAT::ascii;
+    options.polyhedron_faces = geode::VTK_POLYHEDRON_FACES::legacy;
+    const auto output_filename = "polyhedra_face_offsets.vtu";
+    {
+        const ScopedVTKOutputOptions scoped_options{ options };
+        geode::save_polyhedral_solid( solid, output_filename );
+    }
+    // Only the VTK_POLYHEDRON cell has faces: 1 number of faces, then 2
+    // pentagons and 5 quads with their number of vertices
+    const auto face_offsets =
+        data_array_text( output_filename, "faceoffsets" );
+    geode::OpenGeodeIOMeshException::test( face_offsets == "38 -1 ",
+        "Tetrahedron should have a -1 face offset, get ", face_offsets );
+    const auto faces = data_array_text( output_filename, "faces" );
+    const std::vector< std::string_view > face_values =
+        absl::StrSplit( faces, ' ', absl::SkipEmpty() );
+    geode::OpenGeodeIOMeshException::test(
+        absl::StartsWith( faces, "7 5 0 4 3 2 1 " )
+            && face_values.size() == 38,
+        "Faces should only be written for the VTK_POLYHEDRON cell" );
+}
+
+void run_polyhedral_test()
+{
+    const auto solid = create_polyhedra();
+    for( const auto faces : { geode::VTK_POLYHEDRON_FACES::legacy,
+             geode::VTK_POLYHEDRON_FACES::vtk_9_4 } )
+    {
+        geode::VTKOutputOptions options;
+        options.polyhedron_faces = faces;
+        const auto output_filename = absl::StrCat(
+            "polyhedra", static_cast< int >( faces ), ".vtu" );
+        {
+            const ScopedVTKOutputOptions scoped_options{ options };
+            geode::save_polyhedral_solid( *solid, output_filename );
+        }
+        auto reload = geode::load_polyhedral_solid< 3 >( output_filename );
+        check( *reload, { 11, 2 } );
+        geode::OpenGeodeIOMeshException::test(
+            reload->nb_polyhedron_facets( 0 ) == 7,
+            "Reloaded polyhedron should have 7 facets" );
+    }
+    test_polyhedron_face_offsets( *solid );
+}
+
 int main()
 {
     try
@@ -137,6 +441,7 @@ int main()
         run_solid_test( "cone_append_encoded.vtu", { 580, 2197 }, 0.624858 );
         run_surface_test( "cone.vtu", { 580, 1182 }, 0.336177 );
         run_surface_test( "mymesh.vtu", { 283308, 564408 }, 1 );
+        run_polyhedral_test();
 
         geode::Logger::info( "TEST SUCCESS" );
         return 0;